@@ -0,0 +1,269 @@
+#include <algorithm>
+#include <cstdlib>
+#include <string>
+
+#include "arq_simulator.h"
+
+// @brief:  prepare the timing of the link
+// @params: ArqProtocol protocol
+//          ArqLink link
+// @author: Donghan Xia, 2026/10/17
+ArqSimulator::ArqSimulator(const ArqProtocol &protocol, const ArqLink &link)
+        : protocol_(protocol), frame_time_(link.frame_bit_count / link.bit_rate), ack_time_(ARQ_ACK_BITS / link.bit_rate),
+        propagation_delay_(link.propagation_delay) {
+    if (protocol_.kind == ArqProtocol::STOP_AND_WAIT) {
+        protocol_.window_size = 1;
+    }
+    timeout_interval_ = ARQ_TIMEOUT_FACTOR * (frame_time_ + ack_time_ + 2 * propagation_delay_);
+}
+
+// @brief:  start a new run with empty queues
+// @params: uint64_t frame_count
+// @return: void
+// @author: Donghan Xia, 2026/10/17
+void ArqSimulator::Reset(uint64_t frame_count) {
+    frame_count_ = frame_count;
+    counts_ = ArqCounts();
+    now_ = 0;
+    events_ = decltype(events_)();
+    next_event_index_ = 0;
+
+    base_ = 0;
+    next_sequence_ = 0;
+    next_to_send_ = 0;
+    is_link_busy_ = false;
+    last_transmissions_.assign(protocol_.window_size, 0);
+    acked_flags_.assign(protocol_.window_size, 0);
+    resend_sequences_.clear();
+
+    expected_sequence_ = 0;
+    received_flags_.assign(protocol_.window_size, 0);
+    corrupted_flags_.assign(protocol_.window_size, 0);
+}
+
+// @brief:  add an event to the heap
+// @params: double time
+//          ArqEvent::Kind kind
+//          uint64_t sequence
+//          uint64_t transmission_index
+//          ChannelOutcome outcome, of a frame arrival
+// @return: void
+// @author: Donghan Xia, 2026/10/17
+void ArqSimulator::Schedule(double time, ArqEvent::Kind kind, uint64_t sequence, uint64_t transmission_index,
+        ChannelOutcome outcome) {
+    events_.push({time, next_event_index_++, kind, sequence, transmission_index, outcome});
+}
+
+// @brief:  choose the frame the sender puts on the link now, if the link is idle: a Selective
+//          ... Repeat frame that timed out first, then the next frame inside the window
+// @params: uint64_t &sequence, the pass by reference params to store the frame
+// @return: bool, false if nothing is sent now
+// @author: Donghan Xia, 2026/10/17
+bool ArqSimulator::NextTransmission(uint64_t &sequence) {
+    if (is_link_busy_) {
+        return false;
+    }
+    uint64_t window_end = std::min(base_ + protocol_.window_size, frame_count_);
+
+    if (protocol_.kind != ArqProtocol::SELECTIVE_REPEAT) {
+        if (next_to_send_ >= window_end) {
+            return false;
+        }
+        sequence = next_to_send_++;
+        return true;
+    }
+
+    while (!resend_sequences_.empty()) {
+        sequence = resend_sequences_.front();
+        resend_sequences_.pop_front();
+        // acknowledged while it waited
+        if (sequence >= base_ && !acked_flags_[sequence % protocol_.window_size]) {
+            return true;
+        }
+    }
+    if (next_sequence_ >= window_end) {
+        return false;
+    }
+    sequence = next_sequence_++;
+    return true;
+}
+
+// @brief:  put a frame on the link, it arrives one frame time and one propagation delay later and
+//          ... its timer runs from now
+// @params: uint64_t sequence
+//          ChannelOutcome outcome, what the channel does to this transmission
+// @return: void
+// @author: Donghan Xia, 2026/10/17
+void ArqSimulator::Transmit(uint64_t sequence, ChannelOutcome outcome) {
+    uint64_t transmission_index = ++counts_.transmission_count;
+    last_transmissions_[sequence % protocol_.window_size] = transmission_index;
+    is_link_busy_ = true;
+
+    Schedule(now_ + frame_time_, ArqEvent::LINK_IDLE, sequence);
+    Schedule(now_ + frame_time_ + propagation_delay_, ArqEvent::FRAME_ARRIVAL, sequence, transmission_index, outcome);
+    Schedule(now_ + timeout_interval_, ArqEvent::TIMEOUT, sequence, transmission_index);
+}
+
+// @brief:  advance the time to the earliest event and handle it
+// @params: void
+// @return: void
+// @author: Donghan Xia, 2026/10/17
+void ArqSimulator::ProcessNextEvent() {
+    ArqEvent event = events_.top();
+    events_.pop();
+    now_ = event.time;
+
+    switch (event.kind) {
+    case ArqEvent::LINK_IDLE:
+        is_link_busy_ = false;
+        break;
+    case ArqEvent::FRAME_ARRIVAL:
+        ReceiveFrame(event);
+        break;
+    case ArqEvent::ACK_ARRIVAL:
+        ReceiveAck(event);
+        break;
+    case ArqEvent::TIMEOUT:
+        HandleTimeout(event);
+        break;
+    }
+}
+
+// @brief:  the receiver drops a rejected frame without an acknowledgement and delivers the accepted
+//          ... ones in order: Go-Back-N only accepts the expected frame and acknowledges the next
+//          ... one it expects, Selective Repeat keeps the frames inside its window and
+//          ... acknowledges each one
+// @params: ArqEvent event
+// @return: void
+// @author: Donghan Xia, 2026/10/17
+void ArqSimulator::ReceiveFrame(const ArqEvent &event) {
+    if (event.outcome == CHANNEL_DETECTED) {
+        return;
+    }
+    double ack_arrival_time = now_ + ack_time_ + propagation_delay_;
+    size_t window_size = protocol_.window_size;
+
+    if (protocol_.kind != ArqProtocol::SELECTIVE_REPEAT) {
+        if (event.sequence == expected_sequence_) {
+            expected_sequence_++;
+            counts_.delivered_count++;
+            counts_.corrupted_count += event.outcome == CHANNEL_UNDETECTED;
+            counts_.elapsed_time = now_;
+        }
+        Schedule(ack_arrival_time, ArqEvent::ACK_ARRIVAL, expected_sequence_);
+        return;
+    }
+
+    // a frame before the window is a copy of a delivered one whose acknowledgement came too late
+    if (event.sequence >= expected_sequence_ && event.sequence < expected_sequence_ + window_size) {
+        size_t slot_index = event.sequence % window_size;
+        if (!received_flags_[slot_index]) {
+            received_flags_[slot_index] = 1;
+            corrupted_flags_[slot_index] = event.outcome == CHANNEL_UNDETECTED;
+        }
+        while (received_flags_[expected_sequence_ % window_size]) {
+            slot_index = expected_sequence_ % window_size;
+            counts_.delivered_count++;
+            counts_.corrupted_count += corrupted_flags_[slot_index];
+            received_flags_[slot_index] = 0;
+            expected_sequence_++;
+            counts_.elapsed_time = now_;
+        }
+    }
+    Schedule(ack_arrival_time, ArqEvent::ACK_ARRIVAL, event.sequence);
+}
+
+// @brief:  slide the window of the sender: a Go-Back-N acknowledgement covers every frame before
+//          ... the one it names, a Selective Repeat one only the frame it names
+// @params: ArqEvent event
+// @return: void
+// @author: Donghan Xia, 2026/10/17
+void ArqSimulator::ReceiveAck(const ArqEvent &event) {
+    if (protocol_.kind != ArqProtocol::SELECTIVE_REPEAT) {
+        if (event.sequence > base_) {
+            base_ = event.sequence;
+            next_to_send_ = std::max(next_to_send_, base_);
+        }
+        return;
+    }
+
+    size_t window_size = protocol_.window_size;
+    if (event.sequence < base_ || event.sequence >= next_sequence_) {
+        return;
+    }
+    acked_flags_[event.sequence % window_size] = 1;
+    while (base_ < next_sequence_ && acked_flags_[base_ % window_size]) {
+        acked_flags_[base_ % window_size] = 0;
+        base_++;
+    }
+}
+
+// @brief:  a timer that ran out before its frame was acknowledged, and whose frame was not sent
+//          ... again since: Go-Back-N only keeps the timer of the oldest frame and goes back to it,
+//          ... Selective Repeat resends that frame alone
+// @params: ArqEvent event
+// @return: void
+// @author: Donghan Xia, 2026/10/17
+void ArqSimulator::HandleTimeout(const ArqEvent &event) {
+    size_t slot_index = event.sequence % protocol_.window_size;
+    if (event.sequence < base_ || last_transmissions_[slot_index] != event.transmission_index) {
+        return;
+    }
+
+    if (protocol_.kind != ArqProtocol::SELECTIVE_REPEAT) {
+        if (event.sequence == base_) {
+            next_to_send_ = base_;
+        }
+    } else if (!acked_flags_[slot_index]) {
+        resend_sequences_.push_back(event.sequence);
+    }
+}
+
+// @brief:  parse an ARQ protocol: "saw" for stop-and-wait, "gbn:<window>" for Go-Back-N or
+//          ... "sr:<window>" for Selective Repeat, the window counts frames
+// @params: std::string protocol_name
+//          ArqProtocol &protocol, the pass by reference params to store the result
+// @return: bool, false if the protocol is unknown or the window is not positive
+// @author: Donghan Xia, 2026/10/17
+bool ParseArqProtocol(const std::string &protocol_name, ArqProtocol &protocol) {
+    if (protocol_name == "saw") {
+        protocol.kind = ArqProtocol::STOP_AND_WAIT;
+        protocol.window_size = 1;
+        return true;
+    }
+
+    size_t split_position = protocol_name.find(':');
+    if (split_position == protocol_name.npos) {
+        return false;
+    }
+    std::string kind_name = protocol_name.substr(0, split_position);
+    const char *value_data = protocol_name.c_str() + split_position + 1;
+    char *value_end = nullptr;
+    long long window_size = strtoll(value_data, &value_end, 10);
+    if (*value_data == '\0' || *value_end != '\0' || window_size < 1) {
+        return false;
+    }
+
+    if (kind_name == "gbn") {
+        protocol.kind = ArqProtocol::GO_BACK_N;
+    } else if (kind_name == "sr") {
+        protocol.kind = ArqProtocol::SELECTIVE_REPEAT;
+    } else {
+        return false;
+    }
+    protocol.window_size = window_size;
+    return true;
+}
+
+// @brief:  get the goodput of a run: the bits/s of the payloads delivered without errors, a payload
+//          ... with undetected errors is delivered but worth nothing
+// @params: ArqCounts counts
+//          size_t payload_length, bits per payload
+// @return: double
+// @author: Donghan Xia, 2026/10/17
+double GetArqGoodput(const ArqCounts &counts, size_t payload_length) {
+    if (counts.elapsed_time <= 0) {
+        return 0;
+    }
+    return (double) (counts.delivered_count - counts.corrupted_count) * payload_length / counts.elapsed_time;
+}
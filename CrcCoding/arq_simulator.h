@@ -0,0 +1,179 @@
+#ifndef ARQ_SIMULATOR_H
+#define ARQ_SIMULATOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <queue>
+#include <string>
+#include <vector>
+
+#include "monte_carlo.h"
+
+// default link of the ARQ mode, 10 Mbit/s with a one-way propagation delay of 5 ms
+#define DEFAULT_ARQ_LINK_RATE 1e7
+#define DEFAULT_ARQ_LINK_DELAY 0.005
+// default number of payloads delivered at every point of the ARQ grid
+#define DEFAULT_ARQ_FRAME_COUNT ((uint64_t) 1 << 20)
+// number of payloads delivered by one task of the ARQ mode, every task has its own random generator
+#define ARQ_TASK_FRAMES ((uint64_t) 1 << 14)
+// bits of the frame header (sequence number and length), covered by the code like the payload
+#define ARQ_HEADER_BITS 32
+// bits of an acknowledgement, which is assumed to always arrive intact
+#define ARQ_ACK_BITS 64
+// the retransmission timer is this many round trips of a frame and its acknowledgement
+#define ARQ_TIMEOUT_FACTOR 1.5
+// a run gives up after this many transmissions per payload, e.g. when hardly any frame gets through
+#define ARQ_MAX_TRANSMISSIONS_PER_FRAME 1000
+
+// automatic repeat request protocol of the ARQ mode, see ParseArqProtocol()
+struct ArqProtocol {
+    enum Kind {
+        // one frame at a time, the next one is only sent once the previous one is acknowledged
+        STOP_AND_WAIT,
+        // a window of frames in flight, a timeout resends the oldest one and every one after it
+        GO_BACK_N,
+        // a window of frames in flight, a timeout resends only that frame and the receiver keeps
+        // ... the frames after a missing one
+        SELECTIVE_REPEAT,
+    };
+
+    Kind kind = STOP_AND_WAIT;
+    size_t window_size = 1;
+};
+
+// the link of one ARQ run
+struct ArqLink {
+    // bits per second in each direction
+    double bit_rate = DEFAULT_ARQ_LINK_RATE;
+    // one-way propagation delay in seconds
+    double propagation_delay = DEFAULT_ARQ_LINK_DELAY;
+    // bits of one frame: the header, the payload and the check bits
+    size_t frame_bit_count = 0;
+};
+
+// counts of one ARQ run
+struct ArqCounts {
+    // payloads handed over by the receiver, in order
+    uint64_t delivered_count = 0;
+    // delivered payloads with errors the code accepted
+    uint64_t corrupted_count = 0;
+    uint64_t transmission_count = 0;
+    // simulated seconds until the last payload was delivered
+    double elapsed_time = 0;
+};
+
+// an event of the ARQ simulation, ordered by time and then by the order the events were scheduled
+struct ArqEvent {
+    enum Kind {
+        // the sender finished putting a frame on the link
+        LINK_IDLE,
+        FRAME_ARRIVAL,
+        ACK_ARRIVAL,
+        TIMEOUT,
+    };
+
+    double time;
+    uint64_t event_index;
+    Kind kind;
+    // the frame, or for an acknowledgement of Go-Back-N the next frame the receiver expects
+    uint64_t sequence;
+    // the transmission the frame or the timer belongs to
+    uint64_t transmission_index;
+    ChannelOutcome outcome;
+
+    bool operator>(const ArqEvent &other) const {
+        return time != other.time ? time > other.time : event_index > other.event_index;
+    }
+};
+
+// discrete-event simulation of one ARQ run: the sender, the link in both directions and the receiver
+// ... only change state at the events of a binary heap, so a run costs O(log n) per frame and
+// ... acknowledgement instead of a step per time slot, whatever the delay and the window
+// the channel is asked for the outcome of every transmission, which decides whether the receiver
+// ... drops the frame, accepts it, or accepts it with errors
+class ArqSimulator {
+public:
+    ArqSimulator(const ArqProtocol &protocol, const ArqLink &link);
+
+    // @brief:  run until frame_count payloads are delivered, or until the run gives up after
+    //          ... ARQ_MAX_TRANSMISSIONS_PER_FRAME transmissions per payload
+    // @params: uint64_t frame_count
+    //          TransmitFrame transmit_frame, returns the ChannelOutcome of one transmission
+    // @return: ArqCounts
+    // @author: Donghan Xia, 2026/10/17
+    template <typename TransmitFrame>
+    ArqCounts Run(uint64_t frame_count, TransmitFrame transmit_frame) {
+        Reset(frame_count);
+        uint64_t sequence = 0;
+        while (counts_.delivered_count < frame_count_
+                && counts_.transmission_count < frame_count_ * ARQ_MAX_TRANSMISSIONS_PER_FRAME) {
+            if (NextTransmission(sequence)) {
+                Transmit(sequence, transmit_frame());
+            } else if (!events_.empty()) {
+                ProcessNextEvent();
+            } else {
+                break;
+            }
+        }
+        if (counts_.delivered_count < frame_count_) {
+            counts_.elapsed_time = now_;
+        }
+        return counts_;
+    }
+
+private:
+    void Reset(uint64_t frame_count);
+
+    void Schedule(double time, ArqEvent::Kind kind, uint64_t sequence, uint64_t transmission_index = 0,
+            ChannelOutcome outcome = CHANNEL_INTACT);
+
+    bool NextTransmission(uint64_t &sequence);
+
+    void Transmit(uint64_t sequence, ChannelOutcome outcome);
+
+    void ProcessNextEvent();
+
+    void ReceiveFrame(const ArqEvent &event);
+
+    void ReceiveAck(const ArqEvent &event);
+
+    void HandleTimeout(const ArqEvent &event);
+
+    ArqProtocol protocol_;
+    // seconds to send a frame and an acknowledgement, and from sending a frame to its timeout
+    double frame_time_;
+    double ack_time_;
+    double propagation_delay_;
+    double timeout_interval_;
+
+    uint64_t frame_count_ = 0;
+    ArqCounts counts_;
+    double now_ = 0;
+    std::priority_queue<ArqEvent, std::vector<ArqEvent>, std::greater<ArqEvent>> events_;
+    uint64_t next_event_index_ = 0;
+
+    // sender: the oldest frame not acknowledged, the next new frame, and the next frame Go-Back-N
+    // ... sends, which goes back to base_ on a timeout
+    uint64_t base_ = 0;
+    uint64_t next_sequence_ = 0;
+    uint64_t next_to_send_ = 0;
+    bool is_link_busy_ = false;
+    // the window slots of the frames in flight, indexed by sequence % window size
+    std::vector<uint64_t> last_transmissions_;
+    std::vector<uint8_t> acked_flags_;
+    // Selective Repeat frames whose timer ran out, resent before any new frame
+    std::deque<uint64_t> resend_sequences_;
+
+    // receiver: the next frame to deliver, and for Selective Repeat the frames kept after it
+    uint64_t expected_sequence_ = 0;
+    std::vector<uint8_t> received_flags_;
+    std::vector<uint8_t> corrupted_flags_;
+};
+
+bool ParseArqProtocol(const std::string &protocol_name, ArqProtocol &protocol);
+
+double GetArqGoodput(const ArqCounts &counts, size_t payload_length);
+
+#endif
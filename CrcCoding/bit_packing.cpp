@@ -0,0 +1,266 @@
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <immintrin.h>
+
+#include "bit_packing.h"
+
+// @brief:  reverse the bit order of every byte value, used by the SSE2 parser whose movemask
+//          ... puts the first character of a byte into its least significant bit
+// @params: void
+// @return: std::vector<uint8_t>, 256 reversed byte values
+// @author: Donghan Xia, 2026/10/17
+static std::vector<uint8_t> BuildByteReverseTable() {
+    std::vector<uint8_t> reverse_table(256);
+    for (int byte_value = 0; byte_value < 256; byte_value++) {
+        uint8_t reversed = 0;
+        for (int bit_index = 0; bit_index < 8; bit_index++) {
+            reversed |= ((byte_value >> bit_index) & 1) << (7 - bit_index);
+        }
+        reverse_table[byte_value] = reversed;
+    }
+    return reverse_table;
+}
+
+static const std::vector<uint8_t> byte_reverse_table = BuildByteReverseTable();
+
+// @brief:  pack the characters that do not fill a whole SIMD register one at a time
+// @params: const char *bit_data
+//          size_t start_bit, index of the first character to pack
+//          size_t size, number of characters
+//          uint8_t *bytes, output bytes, already zeroed
+// @return: bool, false if there is any character other than '0' and '1'
+// @author: Donghan Xia, 2026/10/17
+static bool PackTailScalar(const char *bit_data, size_t start_bit, size_t size, uint8_t *bytes) {
+    for (size_t bit_index = start_bit; bit_index < size; bit_index++) {
+        char bit_char = bit_data[bit_index];
+        if (bit_char != '0' && bit_char != '1') {
+            return false;
+        }
+        if (bit_char == '1') {
+            bytes[bit_index / 8] |= 0x80 >> (bit_index % 8);
+        }
+    }
+    return true;
+}
+
+// @brief:  pack 16 characters per step with SSE2, the baseline of every x86-64 CPU
+// @params: const char *bit_data
+//          size_t size, number of characters
+//          uint8_t *bytes, output bytes, already zeroed
+// @return: bool, false if there is any character other than '0' and '1'
+// @author: Donghan Xia, 2026/10/17
+static bool PackBitsSse2(const char *bit_data, size_t size, uint8_t *bytes) {
+    const __m128i zero_chars = _mm_set1_epi8('0');
+    const __m128i one_chars = _mm_set1_epi8('1');
+
+    size_t bit_index = 0;
+    for (; bit_index + SSE2_CHAR_COUNT <= size; bit_index += SSE2_CHAR_COUNT) {
+        __m128i chars = _mm_loadu_si128((const __m128i *) (bit_data + bit_index));
+        __m128i is_one = _mm_cmpeq_epi8(chars, one_chars);
+        __m128i is_bit = _mm_or_si128(is_one, _mm_cmpeq_epi8(chars, zero_chars));
+        if (_mm_movemask_epi8(is_bit) != 0xffff) {
+            return false;
+        }
+
+        int one_mask = _mm_movemask_epi8(is_one);
+        bytes[bit_index / 8] = byte_reverse_table[one_mask & 0xff];
+        bytes[bit_index / 8 + 1] = byte_reverse_table[one_mask >> 8];
+    }
+
+    return PackTailScalar(bit_data, bit_index, size, bytes);
+}
+
+// @brief:  pack 32 characters per step with AVX2
+//          the characters of every 8-character group are reversed first, so movemask directly
+//          ... yields bytes whose most significant bit is the first character
+// @params: const char *bit_data
+//          size_t size, number of characters
+//          uint8_t *bytes, output bytes, already zeroed
+// @return: bool, false if there is any character other than '0' and '1'
+// @author: Donghan Xia, 2026/10/17
+__attribute__((target("avx2")))
+static bool PackBitsAvx2(const char *bit_data, size_t size, uint8_t *bytes) {
+    const __m256i zero_chars = _mm256_set1_epi8('0');
+    const __m256i one_chars = _mm256_set1_epi8('1');
+    const __m256i group_reverse_mask = _mm256_setr_epi8(
+        7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8,
+        7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8
+    );
+
+    size_t bit_index = 0;
+    for (; bit_index + AVX2_CHAR_COUNT <= size; bit_index += AVX2_CHAR_COUNT) {
+        __m256i chars = _mm256_loadu_si256((const __m256i *) (bit_data + bit_index));
+        __m256i is_one = _mm256_cmpeq_epi8(chars, one_chars);
+        __m256i is_bit = _mm256_or_si256(is_one, _mm256_cmpeq_epi8(chars, zero_chars));
+        if ((uint32_t) _mm256_movemask_epi8(is_bit) != 0xffffffffu) {
+            return false;
+        }
+
+        uint32_t one_mask = _mm256_movemask_epi8(_mm256_shuffle_epi8(is_one, group_reverse_mask));
+        memcpy(bytes + bit_index / 8, &one_mask, sizeof(one_mask));
+    }
+
+    return PackBitsSse2(bit_data + bit_index, size - bit_index, bytes + bit_index / 8);
+}
+
+typedef bool (*PackBitsFunc)(const char *bit_data, size_t size, uint8_t *bytes);
+
+// @brief:  choose the widest packing kernel supported by the CPU
+// @params: void
+// @return: PackBitsFunc
+// @author: Donghan Xia, 2026/10/17
+static PackBitsFunc DetectPackBitsFunc() {
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        return PackBitsAvx2;
+    }
+    return PackBitsSse2;
+}
+
+// packing kernel selected once at program startup
+static const PackBitsFunc pack_bits_func = DetectPackBitsFunc();
+
+// @brief:  pack a '0'/'1' character sequence into bytes that are already zeroed, so that separate
+//          ... pieces of one long sequence can be packed by separate threads
+// @params: const char *bit_data
+//          size_t size, number of characters
+//          uint8_t *bytes, output bytes, already zeroed
+// @return: bool, false if there is any character other than '0' and '1'
+// @author: Donghan Xia, 2026/10/17
+bool PackBitChars(const char *bit_data, size_t size, uint8_t *bytes) {
+    return pack_bits_func(bit_data, size, bytes);
+}
+
+// @brief:  convert a '0'/'1' character sequence into packed bits
+// @params: const char *bit_data
+//          size_t size, number of characters
+//          PackedBits &packed_data, the pass by reference params to store the result
+// @return: bool, false if there is any character other than '0' and '1'
+// @author: Donghan Xia, 2026/10/17
+bool ParseBitString(const char *bit_data, size_t size, PackedBits &packed_data) {
+    packed_data.bit_count = size;
+    packed_data.words.assign((size + 63) / 64, 0);
+
+    return PackBitChars(bit_data, size, packed_data.Bytes());
+}
+
+// @brief:  convert a '0'/'1' string into packed bits
+// @params: std::string bit_data
+//          PackedBits &packed_data, the pass by reference params to store the result
+// @return: bool, false if there is any character other than '0' and '1'
+// @author: Donghan Xia, 2026/10/17
+bool ParseBitString(const std::string &bit_data, PackedBits &packed_data) {
+    return ParseBitString(bit_data.data(), bit_data.size(), packed_data);
+}
+
+// @brief:  convert packed bits back to a '0'/'1' string
+// @params: PackedBits packed_data
+// @return: std::string
+// @author: Donghan Xia, 2026/10/17
+std::string FormatBitString(const PackedBits &packed_data) {
+    std::string bit_data(packed_data.ByteCount() * 8, '0');
+    const uint8_t *bytes = packed_data.Bytes();
+
+    for (size_t byte_index = 0; byte_index < packed_data.ByteCount(); byte_index++) {
+        uint8_t byte_value = bytes[byte_index];
+        for (int bit_index = 0; bit_index < 8; bit_index++) {
+            bit_data[byte_index * 8 + bit_index] += (byte_value >> (7 - bit_index)) & 1;
+        }
+    }
+    bit_data.resize(packed_data.bit_count);
+
+    return bit_data;
+}
+
+// @brief:  convert the remainder to a binary string with exactly width digits
+// @params: uint64_t remainder
+//          int width, number of CRC result bits
+// @return: std::string
+// @author: Donghan Xia, 2026/10/17
+std::string ConvertRemainderToBinary(uint64_t remainder, int width) {
+    std::string binary_data(width, '0');
+    for (int digit_index = 0; digit_index < width; digit_index++) {
+        if ((remainder >> (width - 1 - digit_index)) & 1) {
+            binary_data[digit_index] = '1';
+        }
+    }
+
+    return binary_data;
+}
+
+// @brief:  read bit_count bits (at most 64) of packed data starting from start_bit as an unsigned value,
+//          ... the first bit read becomes the most significant bit of the result
+// @params: PackedBits packed_data
+//          size_t start_bit
+//          int bit_count
+// @return: uint64_t
+// @author: Donghan Xia, 2026/10/17
+uint64_t ExtractBits(const PackedBits &packed_data, size_t start_bit, int bit_count) {
+    const uint8_t *bytes = packed_data.Bytes();
+    uint64_t value = 0;
+    for (size_t bit_index = start_bit; bit_index < start_bit + bit_count; bit_index++) {
+        value = (value << 1) | ((bytes[bit_index / 8] >> (7 - bit_index % 8)) & 1);
+    }
+
+    return value;
+}
+
+// @brief:  change the number of bits, new bits are zero and dropped bits are cleared so that the
+//          ... unused bits after bit_count stay zero
+// @params: PackedBits &packed_data
+//          size_t bit_count
+// @return: void
+// @author: Donghan Xia, 2026/10/17
+void ResizeBits(PackedBits &packed_data, size_t bit_count) {
+    packed_data.words.resize((bit_count + 63) / 64, 0);
+    packed_data.bit_count = bit_count;
+
+    if (bit_count % 64 != 0) {
+        uint8_t *bytes = packed_data.Bytes();
+        size_t last_byte = bit_count / 8;
+        size_t word_end = packed_data.words.size() * 8;
+        if (bit_count % 8 != 0) {
+            bytes[last_byte] &= 0xff << (8 - bit_count % 8);
+            last_byte++;
+        }
+        memset(bytes + last_byte, 0, word_end - last_byte);
+    }
+}
+
+// @brief:  xor a bit pattern onto target data one word at a time, pattern bits beyond the end of the
+//          ... target data are ignored
+// @params: PackedBits &target_data
+//          PackedBits pattern_data
+// @return: void
+// @author: Donghan Xia, 2026/10/17
+void XorBits(PackedBits &target_data, const PackedBits &pattern_data) {
+    size_t word_count = std::min(target_data.words.size(), pattern_data.words.size());
+    for (size_t word_index = 0; word_index < word_count; word_index++) {
+        target_data.words[word_index] ^= pattern_data.words[word_index];
+    }
+
+    if (pattern_data.bit_count > target_data.bit_count) {
+        ResizeBits(target_data, target_data.bit_count);
+    }
+}
+
+// @brief:  append the lowest bit_count bits of value (at most 64), highest bit first
+// @params: PackedBits &packed_data
+//          uint64_t value
+//          int bit_count
+// @return: void
+// @author: Donghan Xia, 2026/10/17
+void AppendBits(PackedBits &packed_data, uint64_t value, int bit_count) {
+    size_t start_bit = packed_data.bit_count;
+    ResizeBits(packed_data, start_bit + bit_count);
+
+    uint8_t *bytes = packed_data.Bytes();
+    for (int bit_index = 0; bit_index < bit_count; bit_index++) {
+        size_t target_bit = start_bit + bit_index;
+        if ((value >> (bit_count - 1 - bit_index)) & 1) {
+            bytes[target_bit / 8] |= 0x80 >> (target_bit % 8);
+        }
+    }
+}
@@ -0,0 +1,53 @@
+#ifndef BIT_PACKING_H
+#define BIT_PACKING_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// number of bit characters handled by one AVX2 / SSE2 instruction
+#define AVX2_CHAR_COUNT 32
+#define SSE2_CHAR_COUNT 16
+
+// bit data packed into 64-bit words
+// the words are laid out so that the bytes of the data appear in data order in memory and the first
+// ... bit of every byte is its most significant bit: the CRC lookup tables read the words byte by byte,
+// ... while XOR, compare and popcount work a whole word at a time
+// the unused bits after bit_count are always zero
+struct PackedBits {
+    std::vector<uint64_t> words;
+    size_t bit_count = 0;
+
+    const uint8_t *Bytes() const {
+        return reinterpret_cast<const uint8_t *>(words.data());
+    }
+
+    uint8_t *Bytes() {
+        return reinterpret_cast<uint8_t *>(words.data());
+    }
+
+    size_t ByteCount() const {
+        return (bit_count + 7) / 8;
+    }
+};
+
+bool PackBitChars(const char *bit_data, size_t size, uint8_t *bytes);
+
+bool ParseBitString(const char *bit_data, size_t size, PackedBits &packed_data);
+
+bool ParseBitString(const std::string &bit_data, PackedBits &packed_data);
+
+std::string FormatBitString(const PackedBits &packed_data);
+
+std::string ConvertRemainderToBinary(uint64_t remainder, int width);
+
+uint64_t ExtractBits(const PackedBits &packed_data, size_t start_bit, int bit_count);
+
+void ResizeBits(PackedBits &packed_data, size_t bit_count);
+
+void AppendBits(PackedBits &packed_data, uint64_t value, int bit_count);
+
+void XorBits(PackedBits &target_data, const PackedBits &pattern_data);
+
+#endif
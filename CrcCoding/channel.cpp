@@ -0,0 +1,84 @@
+#include <cstdio>
+#include <iostream>
+#include <string>
+
+#include "crc_options.h"
+#include "monte_carlo.h"
+#include "pipeline.h"
+#include "stage_profiler.h"
+#include "channel.h"
+
+// @brief:  flip the error bits of the channel model in a copy of the record, the frame header is
+//          ... left alone so the framing of the stream survives the errors
+// @params: PipelineRecord &record, the pass by reference params of the record
+// @return: bool, always true
+// @author: Donghan Xia, 2026/10/17
+bool InjectChannelErrors::Process(PipelineRecord &record) {
+    size_t byte_count = record.line_data.size();
+    size_t error_count = GenerateErrorBits(generator_, error_model_, byte_count * 8, record.error_bit_data);
+    record_count_++;
+    if (error_count == 0) {
+        return true;
+    }
+    corrupted_count_++;
+    error_bit_count_ += error_count;
+
+    received_data_.assign(record.line_data);
+    const uint8_t *error_bytes = record.error_bit_data.Bytes();
+    for (size_t byte_index = 0; byte_index < byte_count; byte_index++) {
+        received_data_[byte_index] ^= (char) error_bytes[byte_index];
+    }
+    record.line_data = received_data_;
+    return true;
+}
+
+// @brief:  print the counts of the channel to stderr, the records crc_rx did not pass should be
+//          ... exactly the corrupted ones, any fewer were undetected errors
+// @params: void
+// @return: void
+// @author: Donghan Xia, 2026/10/17
+void InjectChannelErrors::Finish() {
+    char count_data[160];
+    snprintf(count_data, sizeof(count_data), "channel records: %llu  corrupted: %llu  flipped bits: %llu",
+            (unsigned long long) record_count_, (unsigned long long) corrupted_count_,
+            (unsigned long long) error_bit_count_);
+    std::cerr << count_data << std::endl;
+}
+
+// @brief:  pass the raw records of a file or stdin to stdout through a channel that flips bits, e.g.
+//          ... crc_tx -i - -F | channel -F -e ber:1e-4 | crc_rx -i - -F, then report the counts and
+//          ... the throughput to stderr
+// @params: std::string input_name, "-" for stdin
+//          size_t record_size, number of bytes per record, 0 for the whole input as one record
+//          bool is_framed, whether the records are length-prefixed frames, record_size is ignored then
+//          ErrorModel error_model
+//          uint64_t seed
+// @return: void
+// @author: Donghan Xia, 2026/10/17
+void RunChannel(const std::string &input_name, size_t record_size, bool is_framed, const ErrorModel &error_model, uint64_t seed) {
+    Pipeline<BinaryRecordSource, InjectChannelErrors, WriteChannelRecords, ThroughputSink> pipeline(
+        BinaryRecordSource(input_name, record_size, is_framed), InjectChannelErrors(error_model, seed),
+        WriteChannelRecords(is_framed), ThroughputSink()
+    );
+    pipeline.Run();
+}
+
+int main(int argc, char *argv[]) {
+
+    CrcOptions options = ParseCrcOptions(argc, argv, CHANNEL_OPTIONS);
+    if (options.is_profiling) {
+        EnableStageProfiling();
+    }
+
+    ErrorModel error_model;
+    ParseErrorModel(options.error_model_name, error_model);
+    // a channel sits in a pipe, so it reads stdin unless told otherwise
+    RunChannel(options.input_name.empty() ? "-" : options.input_name, options.record_size, options.is_framed,
+            error_model, options.seed);
+
+    if (options.is_profiling) {
+        PrintStageProfile();
+    }
+
+    return 0;
+}
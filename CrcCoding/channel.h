@@ -0,0 +1,52 @@
+#include <iostream>
+#include <string>
+
+#include "monte_carlo.h"
+#include "pipeline.h"
+#include "record_reader.h"
+
+// stage: copy the record and flip the error bits of the channel model in the copy, the record then
+// ... points to the copy because the bytes of the source cannot be written
+class InjectChannelErrors : public PipelineStage {
+public:
+    static constexpr ProfileStage kProfileStage = PROFILE_INJECT;
+
+    InjectChannelErrors(const ErrorModel &error_model, uint64_t seed) : error_model_(error_model), generator_(seed) {}
+
+    bool Process(PipelineRecord &record);
+
+    void Finish();
+
+private:
+    ErrorModel error_model_;
+    Xoshiro256 generator_;
+    // the corrupted copy of the current record
+    std::string received_data_;
+    uint64_t record_count_ = 0;
+    // records with at least one flipped bit
+    uint64_t corrupted_count_ = 0;
+    uint64_t error_bit_count_ = 0;
+};
+
+// sink: write every record to stdout, as one frame if framed
+class WriteChannelRecords : public PipelineStage {
+public:
+    static constexpr ProfileStage kProfileStage = PROFILE_OUTPUT;
+
+    explicit WriteChannelRecords(bool is_framed) : record_writer_(is_framed) {}
+
+    bool Process(PipelineRecord &record) {
+        record_writer_.BeginRecord(record.line_data.size());
+        record_writer_.Write(record.line_data);
+        return true;
+    }
+
+    void Finish() {
+        record_writer_.Flush();
+    }
+
+private:
+    RecordWriter record_writer_;
+};
+
+void RunChannel(const std::string &input_name, size_t record_size, bool is_framed, const ErrorModel &error_model, uint64_t seed);
\ No newline at end of file
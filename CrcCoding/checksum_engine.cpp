@@ -0,0 +1,393 @@
+#include <algorithm>
+#include <immintrin.h>
+
+#include "checksum_engine.h"
+
+// @brief:  add two 64-bit sums with end-around carry, i.e. modulo 2^64 - 1
+// @params: uint64_t sum
+//          uint64_t addend
+// @return: uint64_t
+// @author: Donghan Xia, 2026/10/17
+static inline uint64_t AddEndAroundCarry(uint64_t sum, uint64_t addend) {
+    sum += addend;
+    return sum + (sum < addend);
+}
+
+// @brief:  sum the big-endian 32-bit words of whole 16-byte blocks with SSE2, the baseline of every
+//          ... x86-64 CPU
+// @params: const uint8_t *bytes
+//          size_t size, a multiple of CHECKSUM_SSE2_BLOCK_SIZE
+// @return: uint64_t, the sum of the words modulo 2^64 - 1
+// @author: Donghan Xia, 2026/10/17
+static uint64_t SumWordsSse2(const uint8_t *bytes, size_t size) {
+    const __m128i low_word_mask = _mm_set1_epi64x(0xffffffff);
+    __m128i lane_sum = _mm_setzero_si128();
+
+    for (size_t offset = 0; offset < size; offset += CHECKSUM_SSE2_BLOCK_SIZE) {
+        __m128i words = _mm_loadu_si128((const __m128i *) (bytes + offset));
+        // swap the 16-bit halves of every word and then the bytes of every half
+        words = _mm_shufflehi_epi16(_mm_shufflelo_epi16(words, 0xb1), 0xb1);
+        words = _mm_or_si128(_mm_slli_epi16(words, 8), _mm_srli_epi16(words, 8));
+
+        lane_sum = _mm_add_epi64(lane_sum, _mm_and_si128(words, low_word_mask));
+        lane_sum = _mm_add_epi64(lane_sum, _mm_srli_epi64(words, 32));
+    }
+
+    uint64_t lane_sums[2];
+    _mm_storeu_si128((__m128i *) lane_sums, lane_sum);
+    return AddEndAroundCarry(lane_sums[0], lane_sums[1]);
+}
+
+// @brief:  sum the big-endian 32-bit words of whole 32-byte blocks with AVX2
+//          the words are zero-extended into four 64-bit lanes, so no carry is handled in the loop
+//          ... and the lanes are added horizontally only once at the end
+// @params: const uint8_t *bytes
+//          size_t size, a multiple of CHECKSUM_AVX2_BLOCK_SIZE
+// @return: uint64_t, the sum of the words modulo 2^64 - 1
+// @author: Donghan Xia, 2026/10/17
+__attribute__((target("avx2")))
+static uint64_t SumWordsAvx2(const uint8_t *bytes, size_t size) {
+    const __m256i byte_swap_mask = _mm256_setr_epi8(
+        3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12,
+        3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12
+    );
+    const __m256i low_word_mask = _mm256_set1_epi64x(0xffffffff);
+    __m256i lane_sum = _mm256_setzero_si256();
+
+    for (size_t offset = 0; offset < size; offset += CHECKSUM_AVX2_BLOCK_SIZE) {
+        __m256i words = _mm256_shuffle_epi8(_mm256_loadu_si256((const __m256i *) (bytes + offset)), byte_swap_mask);
+        lane_sum = _mm256_add_epi64(lane_sum, _mm256_and_si256(words, low_word_mask));
+        lane_sum = _mm256_add_epi64(lane_sum, _mm256_srli_epi64(words, 32));
+    }
+
+    uint64_t lane_sums[4];
+    _mm256_storeu_si256((__m256i *) lane_sums, lane_sum);
+    uint64_t sum = 0;
+    for (uint64_t lane_value : lane_sums) {
+        sum = AddEndAroundCarry(sum, lane_value);
+    }
+    return sum;
+}
+
+typedef uint64_t (*SumWordsFunc)(const uint8_t *bytes, size_t size);
+
+struct SumWordsKernel {
+    SumWordsFunc sum_func;
+    size_t block_size;
+};
+
+// @brief:  choose the widest summing kernel supported by the CPU
+// @params: void
+// @return: SumWordsKernel
+// @author: Donghan Xia, 2026/10/17
+static SumWordsKernel DetectSumWordsKernel() {
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        return {SumWordsAvx2, CHECKSUM_AVX2_BLOCK_SIZE};
+    }
+    return {SumWordsSse2, CHECKSUM_SSE2_BLOCK_SIZE};
+}
+
+// summing kernel selected once at program startup
+static const SumWordsKernel sum_words_kernel = DetectSumWordsKernel();
+
+// @brief:  decide if the checksum can be calculated on words of data_size bits
+// @params: int data_size
+// @return: bool
+// @author: Donghan Xia, 2026/10/17
+bool IsChecksumWidthSupported(int data_size) {
+    return data_size == 8 || data_size == 16 || data_size == 32;
+}
+
+// @brief:  sum the data as big-endian 32-bit words without folding the carries back in, the data
+//          ... is complemented with zeros to whole words
+// @params: const uint8_t *bytes, packed data, the first bit is the most significant bit of a byte
+//          size_t bit_count, number of leading bits to sum
+// @return: uint64_t, the sum modulo 2^64 - 1, see GetBinaryChecksum() for the fold
+// @author: Donghan Xia, 2026/10/17
+uint64_t SumChecksumWords(const uint8_t *bytes, size_t bit_count) {
+    size_t full_byte_count = bit_count / 8;
+    size_t vector_byte_count = full_byte_count / sum_words_kernel.block_size * sum_words_kernel.block_size;
+
+    uint64_t word_sum = 0;
+    for (size_t offset = 0; offset < vector_byte_count; offset += CHECKSUM_FOLD_BLOCK_SIZE) {
+        size_t block_size = std::min(CHECKSUM_FOLD_BLOCK_SIZE, vector_byte_count - offset);
+        word_sum = AddEndAroundCarry(word_sum, sum_words_kernel.sum_func(bytes + offset, block_size));
+    }
+
+    // the bytes that do not fill a whole block, the last section is complemented with zeros
+    uint32_t tail_word = 0;
+    for (size_t byte_index = vector_byte_count; byte_index < full_byte_count; byte_index++) {
+        tail_word |= (uint32_t) bytes[byte_index] << (24 - 8 * (byte_index % 4));
+        if (byte_index % 4 == 3) {
+            word_sum = AddEndAroundCarry(word_sum, tail_word);
+            tail_word = 0;
+        }
+    }
+    if (bit_count % 8 != 0) {
+        uint8_t last_byte = bytes[full_byte_count] & (0xff << (8 - bit_count % 8));
+        tail_word |= (uint32_t) last_byte << (24 - 8 * (full_byte_count % 4));
+    }
+
+    return AddEndAroundCarry(word_sum, tail_word);
+}
+
+// @brief:  calculate binary checksum data
+//          the carries above data_size bits are wrapped around until the sum fits in data_size bits
+// @params: uint64_t decimal_sum
+//          int data_size, binary data size that decides the size of binary result data
+// @return: uint32_t, complemented checksum of data_size bits
+// @author: Donghan Xia, 2021/09/25
+uint32_t GetBinaryChecksum(uint64_t decimal_sum, int data_size) {
+    uint64_t complementary_base = ((uint64_t) 1 << data_size) - 1;
+    while (decimal_sum > complementary_base) {
+        decimal_sum = (decimal_sum & complementary_base) + (decimal_sum >> data_size);
+    }
+
+    return complementary_base - decimal_sum;
+}
+
+// @brief:  one's complement checksum of the data on words of data_size bits, e.g. the Internet
+//          ... checksum of RFC 1071 on 16-bit words
+// @params: const uint8_t *bytes
+//          size_t bit_count
+//          int data_size, word width: 8, 16 or 32
+// @return: uint32_t, checksum of data_size bits
+// @author: Donghan Xia, 2026/10/17
+uint32_t ComputeChecksum(const uint8_t *bytes, size_t bit_count, int data_size) {
+    return GetBinaryChecksum(SumChecksumWords(bytes, bit_count), data_size);
+}
+
+// @brief:  add the big-endian words of the data to the word sum and every running word sum to the
+//          ... running sum, one word at a time and without any modulo
+// @params: WordBytes, 1 or 2 bytes per word
+//          const uint8_t *bytes
+//          size_t size, a multiple of WordBytes
+//          uint64_t &word_sum
+//          uint64_t &running_sum
+// @return: void
+// @author: Donghan Xia, 2026/10/17
+template <int WordBytes>
+static void SumFletcherWordsScalar(const uint8_t *bytes, size_t size, uint64_t &word_sum, uint64_t &running_sum) {
+    for (size_t offset = 0; offset < size; offset += WordBytes) {
+        uint32_t word = bytes[offset];
+        if (WordBytes == 2) {
+            word = (word << 8) | bytes[offset + 1];
+        }
+        word_sum += word;
+        running_sum += word_sum;
+    }
+}
+
+// @brief:  add up the four 64-bit lanes
+// @params: __m256i lanes
+// @return: uint64_t
+// @author: Donghan Xia, 2026/10/17
+__attribute__((target("avx2")))
+static inline uint64_t AddLanes64(__m256i lanes) {
+    __m128i half_sum = _mm_add_epi64(_mm256_castsi256_si128(lanes), _mm256_extracti128_si256(lanes, 1));
+    return (uint64_t) _mm_cvtsi128_si64(half_sum) + (uint64_t) _mm_extract_epi64(half_sum, 1);
+}
+
+// @brief:  add up the eight 32-bit lanes
+// @params: __m256i lanes
+// @return: uint64_t
+// @author: Donghan Xia, 2026/10/17
+__attribute__((target("avx2")))
+static inline uint64_t AddLanes32(__m256i lanes) {
+    __m256i low_lanes = _mm256_and_si256(lanes, _mm256_set1_epi64x(0xffffffff));
+    return AddLanes64(_mm256_add_epi64(low_lanes, _mm256_srli_epi64(lanes, 32)));
+}
+
+// @brief:  Fletcher sums of bytes, 32 bytes per step with AVX2
+//          for a block of n words w_0 .. w_(n-1) the running sum grows by
+//          ... n * word_sum + sum((n - i) * w_i), so the loop only keeps the byte sums (vpsadbw),
+//          ... the sums of the byte sums of the previous blocks and the byte sums weighted by their
+//          ... distance to the block end (vpmaddubsw); the three are combined once per call
+// @params: const uint8_t *bytes
+//          size_t size, a multiple of CHECKSUM_AVX2_BLOCK_SIZE
+//          uint64_t &word_sum
+//          uint64_t &running_sum
+// @return: void
+// @author: Donghan Xia, 2026/10/17
+__attribute__((target("avx2")))
+static void SumFletcherBytesAvx2(const uint8_t *bytes, size_t size, uint64_t &word_sum, uint64_t &running_sum) {
+    const __m256i byte_weights = _mm256_setr_epi8(
+        32, 31, 30, 29, 28, 27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 17,
+        16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1
+    );
+    const __m256i pair_ones = _mm256_set1_epi16(1);
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i block_sum = zero;
+    __m256i previous_sum = zero;
+    __m256i weighted_sum = zero;
+
+    for (size_t offset = 0; offset < size; offset += CHECKSUM_AVX2_BLOCK_SIZE) {
+        __m256i data = _mm256_loadu_si256((const __m256i *) (bytes + offset));
+        previous_sum = _mm256_add_epi64(previous_sum, block_sum);
+        block_sum = _mm256_add_epi64(block_sum, _mm256_sad_epu8(data, zero));
+        weighted_sum = _mm256_add_epi32(weighted_sum, _mm256_madd_epi16(_mm256_maddubs_epi16(data, byte_weights), pair_ones));
+    }
+
+    running_sum += size * word_sum + CHECKSUM_AVX2_BLOCK_SIZE * AddLanes64(previous_sum) + AddLanes32(weighted_sum);
+    word_sum += AddLanes64(block_sum);
+}
+
+// @brief:  Fletcher sums of big-endian 16-bit words, 16 words per step with AVX2
+//          same as SumFletcherBytesAvx2(), but the high and the low bytes of the words are summed
+//          ... and weighted separately and merged as high * 256 + low once per call
+// @params: const uint8_t *bytes
+//          size_t size, a multiple of CHECKSUM_AVX2_BLOCK_SIZE
+//          uint64_t &word_sum
+//          uint64_t &running_sum
+// @return: void
+// @author: Donghan Xia, 2026/10/17
+__attribute__((target("avx2")))
+static void SumFletcherWordsAvx2(const uint8_t *bytes, size_t size, uint64_t &word_sum, uint64_t &running_sum) {
+    const __m256i high_weights = _mm256_setr_epi8(
+        16, 0, 15, 0, 14, 0, 13, 0, 12, 0, 11, 0, 10, 0, 9, 0,
+        8, 0, 7, 0, 6, 0, 5, 0, 4, 0, 3, 0, 2, 0, 1, 0
+    );
+    const __m256i low_weights = _mm256_slli_epi16(high_weights, 8);
+    const __m256i high_mask = _mm256_set1_epi16(0x00ff);
+    const __m256i pair_ones = _mm256_set1_epi16(1);
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i high_sum = zero;
+    __m256i low_sum = zero;
+    __m256i previous_high_sum = zero;
+    __m256i previous_low_sum = zero;
+    __m256i weighted_high_sum = zero;
+    __m256i weighted_low_sum = zero;
+
+    for (size_t offset = 0; offset < size; offset += CHECKSUM_AVX2_BLOCK_SIZE) {
+        __m256i data = _mm256_loadu_si256((const __m256i *) (bytes + offset));
+        previous_high_sum = _mm256_add_epi64(previous_high_sum, high_sum);
+        previous_low_sum = _mm256_add_epi64(previous_low_sum, low_sum);
+        high_sum = _mm256_add_epi64(high_sum, _mm256_sad_epu8(_mm256_and_si256(data, high_mask), zero));
+        low_sum = _mm256_add_epi64(low_sum, _mm256_sad_epu8(_mm256_andnot_si256(high_mask, data), zero));
+        weighted_high_sum = _mm256_add_epi32(weighted_high_sum, _mm256_madd_epi16(_mm256_maddubs_epi16(data, high_weights), pair_ones));
+        weighted_low_sum = _mm256_add_epi32(weighted_low_sum, _mm256_madd_epi16(_mm256_maddubs_epi16(data, low_weights), pair_ones));
+    }
+
+    uint64_t block_word_sum = AddLanes64(high_sum) * 256 + AddLanes64(low_sum);
+    uint64_t previous_word_sum = AddLanes64(previous_high_sum) * 256 + AddLanes64(previous_low_sum);
+    uint64_t weighted_word_sum = AddLanes32(weighted_high_sum) * 256 + AddLanes32(weighted_low_sum);
+
+    running_sum += size / 2 * word_sum + CHECKSUM_AVX2_BLOCK_SIZE / 2 * previous_word_sum + weighted_word_sum;
+    word_sum += block_word_sum;
+}
+
+// add a whole number of blocks to the Fletcher sums without any modulo
+typedef void (*SumFletcherFunc)(const uint8_t *bytes, size_t size, uint64_t &word_sum, uint64_t &running_sum);
+
+// @brief:  choose the Fletcher kernel of 1- or 2-byte words supported by the CPU
+// @params: int word_bytes
+// @return: SumFletcherFunc
+// @author: Donghan Xia, 2026/10/17
+static SumFletcherFunc DetectSumFletcherFunc(int word_bytes) {
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        return word_bytes == 1 ? SumFletcherBytesAvx2 : SumFletcherWordsAvx2;
+    }
+    return word_bytes == 1 ? SumFletcherWordsScalar<1> : SumFletcherWordsScalar<2>;
+}
+
+// Fletcher kernels selected once at program startup
+static const SumFletcherFunc sum_fletcher_bytes_func = DetectSumFletcherFunc(1);
+static const SumFletcherFunc sum_fletcher_words_func = DetectSumFletcherFunc(2);
+
+// @brief:  Fletcher / Adler checksum of the leading bit_count bits, the data is complemented with
+//          ... zeros to whole words
+// @params: const uint8_t *bytes
+//          size_t bit_count
+//          int word_bytes, 1 or 2 bytes per word
+//          uint32_t modulus
+//          uint64_t initial_sum, initial word sum, 1 for Adler-32
+//          int sum_shift, the running sum is placed above the word sum by this many bits
+// @return: uint32_t
+// @author: Donghan Xia, 2026/10/17
+static uint32_t ComputeFletcher(const uint8_t *bytes, size_t bit_count, int word_bytes, uint32_t modulus,
+        uint64_t initial_sum, int sum_shift) {
+    SumFletcherFunc sum_func = word_bytes == 1 ? sum_fletcher_bytes_func : sum_fletcher_words_func;
+    size_t full_byte_count = bit_count / 8;
+    size_t vector_byte_count = full_byte_count / CHECKSUM_AVX2_BLOCK_SIZE * CHECKSUM_AVX2_BLOCK_SIZE;
+
+    uint64_t word_sum = initial_sum;
+    uint64_t running_sum = 0;
+    for (size_t offset = 0; offset < vector_byte_count; offset += CHECKSUM_FLETCHER_CHUNK_SIZE) {
+        sum_func(bytes + offset, std::min(CHECKSUM_FLETCHER_CHUNK_SIZE, vector_byte_count - offset), word_sum, running_sum);
+        word_sum %= modulus;
+        running_sum %= modulus;
+    }
+
+    // the bytes that do not fill a whole block, the last word is complemented with zeros
+    uint8_t tail_bytes[CHECKSUM_AVX2_BLOCK_SIZE + 2] = {0};
+    size_t tail_size = full_byte_count - vector_byte_count;
+    std::copy(bytes + vector_byte_count, bytes + full_byte_count, tail_bytes);
+    if (bit_count % 8 != 0) {
+        tail_bytes[tail_size++] = bytes[full_byte_count] & (0xff << (8 - bit_count % 8));
+    }
+    tail_size = (tail_size + word_bytes - 1) / word_bytes * word_bytes;
+
+    if (word_bytes == 1) {
+        SumFletcherWordsScalar<1>(tail_bytes, tail_size, word_sum, running_sum);
+    } else {
+        SumFletcherWordsScalar<2>(tail_bytes, tail_size, word_sum, running_sum);
+    }
+
+    return (uint32_t) (running_sum % modulus) << sum_shift | (uint32_t) (word_sum % modulus);
+}
+
+// @brief:  Fletcher-16 checksum, bytes summed modulo 255
+// @params: const uint8_t *bytes
+//          size_t bit_count
+// @return: uint32_t, checksum of 16 bits
+// @author: Donghan Xia, 2026/10/17
+uint32_t ComputeFletcher16(const uint8_t *bytes, size_t bit_count) {
+    return ComputeFletcher(bytes, bit_count, 1, 255, 0, 8);
+}
+
+// @brief:  Fletcher-32 checksum, big-endian 16-bit words summed modulo 65535
+// @params: const uint8_t *bytes
+//          size_t bit_count
+// @return: uint32_t, checksum of 32 bits
+// @author: Donghan Xia, 2026/10/17
+uint32_t ComputeFletcher32(const uint8_t *bytes, size_t bit_count) {
+    return ComputeFletcher(bytes, bit_count, 2, 65535, 0, 16);
+}
+
+// @brief:  Adler-32 checksum of zlib, bytes summed modulo 65521 starting from 1
+// @params: const uint8_t *bytes
+//          size_t bit_count
+// @return: uint32_t, checksum of 32 bits
+// @author: Donghan Xia, 2026/10/17
+uint32_t ComputeAdler32(const uint8_t *bytes, size_t bit_count) {
+    return ComputeFletcher(bytes, bit_count, 1, 65521, 1, 16);
+}
+
+// @brief:  find a checksum algorithm by name: ones (the one's complement checksum on words of
+//          ... data_size bits), fletcher16, fletcher32 or adler32
+// @params: std::string checksum_name
+//          int data_size, word width of the one's complement checksum
+//          ChecksumAlgorithm &algorithm, the pass by reference params to store the result
+// @return: bool, false if the name is unknown
+// @author: Donghan Xia, 2026/10/17
+bool FindChecksumAlgorithm(const std::string &checksum_name, int data_size, ChecksumAlgorithm &algorithm) {
+    if (checksum_name == "ones" && IsChecksumWidthSupported(data_size)) {
+        static const ChecksumFunc ones_complement_funcs[] = {
+            [](const uint8_t *bytes, size_t bit_count) { return ComputeChecksum(bytes, bit_count, 8); },
+            [](const uint8_t *bytes, size_t bit_count) { return ComputeChecksum(bytes, bit_count, 16); },
+            [](const uint8_t *bytes, size_t bit_count) { return ComputeChecksum(bytes, bit_count, 32); },
+        };
+        algorithm = {ones_complement_funcs[data_size / 16], data_size};
+    } else if (checksum_name == "fletcher16") {
+        algorithm = {ComputeFletcher16, 16};
+    } else if (checksum_name == "fletcher32") {
+        algorithm = {ComputeFletcher32, 32};
+    } else if (checksum_name == "adler32") {
+        algorithm = {ComputeAdler32, 32};
+    } else {
+        return false;
+    }
+    return true;
+}
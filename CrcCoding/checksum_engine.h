@@ -0,0 +1,54 @@
+#ifndef CHECKSUM_ENGINE_H
+#define CHECKSUM_ENGINE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// number of bytes summed by one AVX2 / SSE2 step of the checksum engine
+#define CHECKSUM_AVX2_BLOCK_SIZE 32
+#define CHECKSUM_SSE2_BLOCK_SIZE 16
+// number of bytes summed into the 64-bit lanes before the lanes are folded into the total, far below
+// ... the 2^32 additions of 32-bit words one lane can take without overflow
+#define CHECKSUM_FOLD_BLOCK_SIZE ((size_t) 1 << 30)
+// number of bytes summed by the Fletcher / Adler kernels before the sums are reduced modulo, small
+// ... enough that neither the 32-bit weighted lanes nor the 64-bit running sum can overflow
+#define CHECKSUM_FLETCHER_CHUNK_SIZE ((size_t) 1 << 20)
+// default checksum algorithm, the one's complement checksum
+#define DEFAULT_CHECKSUM_ALGORITHM "ones"
+
+// one's complement checksum of 8-, 16- (RFC 1071) or 32-bit words
+// the data is read as big-endian 32-bit words, i.e. in data order, and summed into 64-bit lanes
+// ... without handling any carry; because 2^8 - 1 and 2^16 - 1 divide 2^32 - 1, which divides
+// ... 2^64 - 1, the end-around carries of every word width are all done once at the end
+bool IsChecksumWidthSupported(int data_size);
+
+uint64_t SumChecksumWords(const uint8_t *bytes, size_t bit_count);
+
+uint32_t GetBinaryChecksum(uint64_t decimal_sum, int data_size);
+
+uint32_t ComputeChecksum(const uint8_t *bytes, size_t bit_count, int data_size);
+
+// Fletcher-16 (bytes modulo 255), Fletcher-32 (big-endian 16-bit words modulo 65535) and Adler-32
+// ... (bytes modulo 65521): a sum of the words and a sum of the running sums, reduced modulo only
+// ... once per CHECKSUM_FLETCHER_CHUNK_SIZE bytes
+uint32_t ComputeFletcher16(const uint8_t *bytes, size_t bit_count);
+
+uint32_t ComputeFletcher32(const uint8_t *bytes, size_t bit_count);
+
+uint32_t ComputeAdler32(const uint8_t *bytes, size_t bit_count);
+
+// calculate the checksum of the leading bit_count bits of packed data
+typedef uint32_t (*ChecksumFunc)(const uint8_t *bytes, size_t bit_count);
+
+// a checksum algorithm chosen at runtime, the checksum is calculated once per record so one indirect
+// ... call per record costs nothing next to the kernels
+struct ChecksumAlgorithm {
+    ChecksumFunc checksum_func;
+    // number of bits of the checksum
+    int checksum_size;
+};
+
+bool FindChecksumAlgorithm(const std::string &checksum_name, int data_size, ChecksumAlgorithm &algorithm);
+
+#endif
@@ -0,0 +1,254 @@
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "crc_options.h"
+#include "crc_template.h"
+#include "crc_weights.h"
+#include "monte_carlo.h"
+#include "pipeline.h"
+#include "legacy_string.h"
+#include "crc_bench.h"
+
+// @brief:  keep the result of a benchmark body alive, so the compiler can neither drop the work
+//          ... nor move it out of the timing loop
+// @params: T value
+// @return: void
+// @author: Donghan Xia, 2026/10/17
+template <typename T>
+static inline void KeepResult(const T &value) {
+    asm volatile("" : : "r"(&value) : "memory");
+}
+
+// @brief:  run a benchmark body with twice the iterations until BENCH_MIN_SECONDS have passed
+// @params: Body body, one operation of the benchmark
+// @return: BenchResult, the average time of one operation
+// @author: Donghan Xia, 2026/10/17
+template <typename Body>
+BenchResult MeasureBenchmark(Body body) {
+    BenchResult result;
+    for (uint64_t iteration_count = 1;; iteration_count *= 2) {
+        auto start_time = std::chrono::steady_clock::now();
+        for (uint64_t iteration_index = 0; iteration_index < iteration_count; iteration_index++) {
+            body();
+        }
+        double elapsed_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+
+        if (elapsed_seconds >= BENCH_MIN_SECONDS) {
+            result.nanoseconds_per_op = elapsed_seconds * 1e9 / iteration_count;
+            result.iteration_count = iteration_count;
+            return result;
+        }
+    }
+}
+
+// @brief:  print the column names of the benchmark table
+// @params: void
+// @return: void
+// @author: Donghan Xia, 2026/10/17
+void PrintBenchHeader() {
+    char row_data[160];
+    snprintf(row_data, sizeof(row_data), "%-22s %-6s %9s %8s %14s %10s %12s %8s", "benchmark", "impl", "bits",
+            "density", "ns/op", "ns/bit", "bytes/s", "speedup");
+    std::cout << row_data << std::endl;
+}
+
+// @brief:  print one row of the benchmark table
+// @params: std::string bench_name
+//          std::string impl_name, legacy or packed
+//          size_t bit_count, number of bits handled by one operation
+//          double error_density, negative if the benchmark does not depend on the error bits
+//          BenchResult result
+//          BenchResult *baseline_result, the legacy result the speedup is relative to, nullptr for none
+// @return: void
+// @author: Donghan Xia, 2026/10/17
+void PrintBenchResult(const std::string &bench_name, const std::string &impl_name, size_t bit_count,
+        double error_density, const BenchResult &result, const BenchResult *baseline_result) {
+    char density_data[16] = "-";
+    if (error_density >= 0) {
+        snprintf(density_data, sizeof(density_data), "%g", error_density);
+    }
+    char speedup_data[16] = "-";
+    if (baseline_result != nullptr) {
+        snprintf(speedup_data, sizeof(speedup_data), "%.1fx", baseline_result->nanoseconds_per_op / result.nanoseconds_per_op);
+    }
+
+    char row_data[160];
+    snprintf(row_data, sizeof(row_data), "%-22s %-6s %9zu %8s %14.1f %10.4f %12.4g %8s", bench_name.c_str(),
+            impl_name.c_str(), bit_count, density_data, result.nanoseconds_per_op,
+            result.nanoseconds_per_op / bit_count, bit_count / 8.0 / (result.nanoseconds_per_op * 1e-9), speedup_data);
+    std::cout << row_data << std::endl;
+}
+
+// @brief:  measure the legacy string implementation of a benchmark and its packed counterpart, and
+//          ... print both rows with the speedup of the packed one
+//          the legacy one is skipped beyond BENCH_LEGACY_MAX_LENGTH
+// @params: std::string bench_name
+//          BenchData bench_data
+//          size_t bit_count, number of bits handled by one operation
+//          double error_density, negative if the benchmark does not depend on the error bits
+//          LegacyBody legacy_body, one operation of the legacy implementation
+//          PackedBody packed_body, one operation of the packed implementation
+// @return: void
+// @author: Donghan Xia, 2026/10/17
+template <typename LegacyBody, typename PackedBody>
+void RunBenchmark(const std::string &bench_name, const BenchData &bench_data, size_t bit_count, double error_density,
+        LegacyBody legacy_body, PackedBody packed_body) {
+    bool has_legacy = bench_data.message_length <= BENCH_LEGACY_MAX_LENGTH;
+    BenchResult legacy_result;
+    if (has_legacy) {
+        legacy_result = MeasureBenchmark(legacy_body);
+        PrintBenchResult(bench_name, "legacy", bit_count, error_density, legacy_result, nullptr);
+    }
+
+    BenchResult packed_result = MeasureBenchmark(packed_body);
+    PrintBenchResult(bench_name, "packed", bit_count, error_density, packed_result, has_legacy ? &legacy_result : nullptr);
+}
+
+// @brief:  build the random message and error bits of one message length and error density
+//          the legacy implementations receive a codeword encoded by their own division, which is
+//          ... the same codeword for the generators without Init, XorOut or reflection (crc12)
+// @params: size_t message_length
+//          double error_density, the bit error rate of the error bits, 0 for none
+//          uint64_t seed
+//          BenchData &bench_data, the pass by reference params to store the result
+// @return: void
+// @author: Donghan Xia, 2026/10/17
+template <typename CrcType>
+void BuildBenchData(size_t message_length, double error_density, uint64_t seed, BenchData &bench_data) {
+    Xoshiro256 generator(seed);
+    bench_data.message_length = message_length;
+    bench_data.error_density = error_density;
+    bench_data.generator_data = FormatGeneratorPolynomial({((uint64_t) 1 << CrcType::kWidth) | CrcType::kPoly, CrcType::kWidth});
+
+    FillRandomBits(generator, message_length, bench_data.message_bits);
+    bench_data.message_data = FormatBitString(bench_data.message_bits);
+
+    size_t codeword_length = message_length + CrcType::kWidth;
+    bench_data.error_bits.bit_count = codeword_length;
+    bench_data.error_bits.words.assign((codeword_length + 63) / 64, 0);
+    if (error_density > 0) {
+        ErrorModel error_model;
+        error_model.kind = ErrorModel::BERNOULLI;
+        error_model.bit_error_rate = error_density;
+        GenerateErrorBits(generator, error_model, codeword_length, bench_data.error_bits);
+    }
+    bench_data.error_bit_data = FormatBitString(bench_data.error_bits);
+
+    bench_data.received_bits = bench_data.message_bits;
+    AppendBits(bench_data.received_bits, CrcType::Compute(bench_data.message_bits), CrcType::kWidth);
+    XorBits(bench_data.received_bits, bench_data.error_bits);
+
+    bench_data.received_data = bench_data.message_data
+            + legacy::EncodeCrc(bench_data.message_data, bench_data.generator_data);
+    legacy::IntroduceErrorBits(bench_data.received_data, bench_data.error_bit_data);
+
+    bench_data.combo_data = bench_data.message_data + " " + bench_data.error_bit_data;
+}
+
+// @brief:  run the benchmarks whose cost only depends on the message length
+// @params: BenchData bench_data
+//          ChecksumAlgorithm checksum_algorithm, the legacy checksum always is the 8-bit one's
+//          ... complement checksum
+// @return: void
+// @author: Donghan Xia, 2026/10/17
+template <typename CrcType>
+void RunLengthBenchmarks(const BenchData &bench_data, const ChecksumAlgorithm &checksum_algorithm) {
+    const std::string &message_data = bench_data.message_data;
+    const PackedBits &message_bits = bench_data.message_bits;
+    size_t message_length = bench_data.message_length;
+
+    RunBenchmark("EncodeCrc", bench_data, message_length, -1,
+            [&]() { KeepResult(legacy::EncodeCrc(message_data, bench_data.generator_data)); },
+            [&]() { KeepResult(CrcType::Compute(message_bits)); });
+
+    RunBenchmark("EncodeChecksum", bench_data, message_length, -1,
+            [&]() { KeepResult(legacy::EncodeChecksum(message_data)); },
+            [&]() { KeepResult(checksum_algorithm.checksum_func(message_bits.Bytes(), message_length)); });
+
+    // the whole message, one 8-bit section at a time for the legacy one
+    PackedBits packed_data;
+    RunBenchmark("ConvertBinaryToDecimal", bench_data, message_length, -1,
+            [&]() {
+                int decimal_sum = 0;
+                for (size_t split_index = 0; split_index < message_length; split_index += 8) {
+                    decimal_sum += legacy::ConvertBinaryToDecimal(message_data.substr(split_index, 8));
+                }
+                KeepResult(decimal_sum);
+            },
+            [&]() { KeepResult(ParseBitString(message_data.data(), message_length, packed_data)); });
+
+    std::string binary_data;
+    RunBenchmark("ConvertDecimalToBinary", bench_data, message_length, -1,
+            [&]() {
+                binary_data.clear();
+                for (size_t byte_index = 0; byte_index < message_bits.ByteCount(); byte_index++) {
+                    binary_data += legacy::ConvertDecimalToBinary(message_bits.Bytes()[byte_index], 8);
+                }
+                KeepResult(binary_data);
+            },
+            [&]() { KeepResult(FormatBitString(message_bits)); });
+
+    RunBenchmark("SplitComboData", bench_data, bench_data.combo_data.size() - 1, -1,
+            [&]() { KeepResult(legacy::SplitComboData(bench_data.combo_data)); },
+            [&]() { KeepResult(SplitComboData(bench_data.combo_data)); });
+}
+
+// @brief:  run the benchmarks whose cost depends on the error bits of the codeword
+// @params: BenchData bench_data
+// @return: void
+// @author: Donghan Xia, 2026/10/17
+template <typename CrcType>
+void RunErrorBenchmarks(const BenchData &bench_data) {
+    size_t codeword_length = bench_data.received_bits.bit_count;
+
+    // introducing the same error bits twice restores the codeword, so it is not copied every time
+    std::string received_data = bench_data.received_data;
+    PackedBits received_bits = bench_data.received_bits;
+    RunBenchmark("IntroduceErrorBits", bench_data, codeword_length, bench_data.error_density,
+            [&]() {
+                legacy::IntroduceErrorBits(received_data, bench_data.error_bit_data);
+                KeepResult(received_data);
+            },
+            [&]() {
+                XorBits(received_bits, bench_data.error_bits);
+                KeepResult(received_bits);
+            });
+
+    RunBenchmark("CheckCrc", bench_data, codeword_length, bench_data.error_density,
+            [&]() { KeepResult(legacy::CheckCrc(bench_data.received_data, bench_data.generator_data)); },
+            [&]() { KeepResult(CrcType::CheckCodeword(bench_data.received_bits)); });
+}
+
+int main(int argc, char *argv[]) {
+
+    CrcOptions options = ParseCrcOptions(argc, argv, CRC_BENCH_OPTIONS);
+
+    ChecksumAlgorithm checksum_algorithm;
+    FindChecksumAlgorithm(options.checksum_name, options.checksum_width, checksum_algorithm);
+
+    DispatchCrcAlgorithm(options.algorithm_name, [&options, &checksum_algorithm](auto crc_algorithm) {
+        typedef decltype(crc_algorithm) CrcType;
+
+        std::cout << "algorithm: " << options.algorithm_name << "  kernel: " << options.kernel_name
+                << "  checksum: " << options.checksum_name << std::endl;
+        PrintBenchHeader();
+
+        for (int message_length : options.message_lengths) {
+            BenchData bench_data;
+            BuildBenchData<CrcType>(message_length, 0, options.seed, bench_data);
+            RunLengthBenchmarks<CrcType>(bench_data, checksum_algorithm);
+
+            for (double error_density : BENCH_ERROR_DENSITIES) {
+                BuildBenchData<CrcType>(message_length, error_density, options.seed, bench_data);
+                RunErrorBenchmarks<CrcType>(bench_data);
+            }
+        }
+    });
+
+    return 0;
+}
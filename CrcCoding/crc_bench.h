@@ -0,0 +1,60 @@
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "bit_packing.h"
+#include "checksum_engine.h"
+
+// minimum measured time of every benchmark in seconds, the iterations double until it is reached
+#define BENCH_MIN_SECONDS 0.1
+// error densities of the benchmarks whose cost depends on the error bits
+#define BENCH_ERROR_DENSITIES {0.001, 0.01, 0.1}
+// longest message the legacy string implementations are measured at: their division copies the
+// ... whole string for every quotient bit, so their time grows with the square of the length
+#define BENCH_LEGACY_MAX_LENGTH 65536
+
+// input of the benchmarks at one message length and error density, as strings for the legacy
+// ... implementations and as packed bits for the current ones
+struct BenchData {
+    size_t message_length = 0;
+    double error_density = 0;
+    std::string generator_data;
+
+    std::string message_data;
+    PackedBits message_bits;
+    // codeword with the error bits introduced
+    std::string received_data;
+    PackedBits received_bits;
+    // error bits of the whole codeword
+    std::string error_bit_data;
+    PackedBits error_bits;
+    // line of dataVs.txt: the message and the error bits separated by a whitespace
+    std::string combo_data;
+};
+
+// time of one benchmark
+struct BenchResult {
+    double nanoseconds_per_op = 0;
+    uint64_t iteration_count = 0;
+};
+
+template <typename Body>
+BenchResult MeasureBenchmark(Body body);
+
+void PrintBenchHeader();
+
+void PrintBenchResult(const std::string &bench_name, const std::string &impl_name, size_t bit_count,
+        double error_density, const BenchResult &result, const BenchResult *baseline_result);
+
+template <typename LegacyBody, typename PackedBody>
+void RunBenchmark(const std::string &bench_name, const BenchData &bench_data, size_t bit_count, double error_density,
+        LegacyBody legacy_body, PackedBody packed_body);
+
+template <typename CrcType>
+void BuildBenchData(size_t message_length, double error_density, uint64_t seed, BenchData &bench_data);
+
+template <typename CrcType>
+void RunLengthBenchmarks(const BenchData &bench_data, const ChecksumAlgorithm &checksum_algorithm);
+
+template <typename CrcType>
+void RunErrorBenchmarks(const BenchData &bench_data);
\ No newline at end of file
@@ -0,0 +1,117 @@
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "crc_template.h"
+#include "crc_kernels.h"
+#include "crc_coding.h"
+
+// the selected algorithm of the C interface, resolved to its Crc instantiation once
+struct CrcCodingAlgorithm {
+    int width;
+    void (*compute_many)(const uint8_t *const *messages, const size_t *sizes, size_t message_count, uint32_t *crc_values);
+};
+
+// @brief:  get the entry points of a CRC algorithm
+// @params: CrcType, the CRC algorithm chosen at compile time
+// @return: CrcCodingAlgorithm
+// @author: Donghan Xia, 2026/10/17
+template <typename CrcType>
+static CrcCodingAlgorithm MakeCodingAlgorithm() {
+    return {CrcType::kWidth, &CrcType::ComputeMany};
+}
+
+// CRC-12, the default algorithm of the tools
+static CrcCodingAlgorithm coding_algorithm = MakeCodingAlgorithm<Crc12>();
+
+// @brief:  select the CRC algorithm of the C interface
+// @params: const char *algorithm_name
+// @return: int, 0, or -1 if the name is unknown
+// @author: Donghan Xia, 2026/10/17
+int crc_select_algorithm(const char *algorithm_name) {
+    if (algorithm_name == nullptr) {
+        return -1;
+    }
+    bool is_known = DispatchCrcAlgorithm(algorithm_name, [](auto crc_algorithm) {
+        coding_algorithm = MakeCodingAlgorithm<decltype(crc_algorithm)>();
+    });
+    return is_known ? 0 : -1;
+}
+
+// @brief:  select the CRC kernel of every algorithm, see SelectCrcKernel()
+// @params: const char *kernel_name
+// @return: int, 0, or -1 if the kernel is unknown or not supported by this CPU
+// @author: Donghan Xia, 2026/10/17
+int crc_select_kernel(const char *kernel_name) {
+    return kernel_name != nullptr && SelectCrcKernel(kernel_name) ? 0 : -1;
+}
+
+// @brief:  get the number of CRC bits of the selected algorithm
+// @params: void
+// @return: int
+// @author: Donghan Xia, 2026/10/17
+int crc_get_width(void) {
+    return coding_algorithm.width;
+}
+
+// @brief:  calculate the CRC of one buffer
+// @params: const uint8_t *buf
+//          size_t len
+// @return: uint32_t
+// @author: Donghan Xia, 2026/10/17
+uint32_t crc_compute(const uint8_t *buf, size_t len) {
+    uint32_t crc_value = 0;
+    coding_algorithm.compute_many(&buf, &len, 1, &crc_value);
+    return crc_value;
+}
+
+// @brief:  calculate the CRC of many buffers, see ComputeMany() in crc_template.h
+// @params: const uint8_t *const *bufs
+//          const size_t *lens
+//          size_t n
+//          uint32_t *out, the pass by reference params to store the CRC values
+// @return: void
+// @author: Donghan Xia, 2026/10/17
+void crc_compute_many(const uint8_t *const *bufs, const size_t *lens, size_t n, uint32_t *out) {
+    coding_algorithm.compute_many(bufs, lens, n, out);
+}
+
+// @brief:  check many codewords: the CRC values of all the payloads are calculated in one batch and
+//          ... compared with the big-endian CRC bytes after them
+// @params: const uint8_t *const *bufs
+//          const size_t *lens, the sizes of the whole codewords
+//          size_t n
+//          int *accepted, the pass by reference params to store the results
+// @return: void
+// @author: Donghan Xia, 2026/10/17
+void crc_check_many(const uint8_t *const *bufs, const size_t *lens, size_t n, int *accepted) {
+    size_t crc_byte_count = (coding_algorithm.width + 7) / 8;
+    // the payloads of the codewords long enough to hold a CRC
+    std::vector<const uint8_t *> payloads;
+    std::vector<size_t> payload_sizes;
+    std::vector<size_t> codeword_indexes;
+    payloads.reserve(n);
+    payload_sizes.reserve(n);
+    codeword_indexes.reserve(n);
+    for (size_t codeword_index = 0; codeword_index < n; codeword_index++) {
+        accepted[codeword_index] = 0;
+        if (lens[codeword_index] >= crc_byte_count) {
+            payloads.push_back(bufs[codeword_index]);
+            payload_sizes.push_back(lens[codeword_index] - crc_byte_count);
+            codeword_indexes.push_back(codeword_index);
+        }
+    }
+
+    std::vector<uint32_t> crc_values(payloads.size());
+    coding_algorithm.compute_many(payloads.data(), payload_sizes.data(), payloads.size(), crc_values.data());
+
+    for (size_t payload_index = 0; payload_index < payloads.size(); payload_index++) {
+        const uint8_t *crc_bytes = payloads[payload_index] + payload_sizes[payload_index];
+        uint32_t received_value = 0;
+        for (size_t byte_index = 0; byte_index < crc_byte_count; byte_index++) {
+            received_value = (received_value << 8) | crc_bytes[byte_index];
+        }
+        accepted[codeword_indexes[payload_index]] = crc_values[payload_index] == received_value;
+    }
+}
@@ -0,0 +1,45 @@
+#ifndef CRC_CODING_H
+#define CRC_CODING_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// the functions exported by libcrccoding.so, every other symbol is built with -fvisibility=hidden
+#define CRC_CODING_API __attribute__((visibility("default")))
+
+// C interface of libcrccoding.a and libcrccoding.so, the same Crc template and kernels as crc_tx and
+// ... crc_rx behind plain functions on byte buffers, so a C or C++ service links one optimized
+// ... implementation instead of converting its data into '0'/'1' strings, e.g.
+//     g++ -I../CrcCoding server.cpp -L../CrcCoding -lcrccoding -pthread
+// the algorithm and the kernel are process-wide, select them once before computing from any thread
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// select the CRC algorithm: crc8, crc12 (the default), crc16, crc32 or crc32c
+// returns 0, or -1 if the name is unknown and the algorithm is left as it was
+CRC_CODING_API int crc_select_algorithm(const char *algorithm_name);
+
+// select the CRC kernel: auto (the default), table, pclmul or sse42
+// returns 0, or -1 if the name is unknown or the CPU cannot run that kernel
+CRC_CODING_API int crc_select_kernel(const char *kernel_name);
+
+// number of CRC bits of the selected algorithm, a codeword ends with (width + 7) / 8 CRC bytes
+CRC_CODING_API int crc_get_width(void);
+
+// CRC of one buffer
+CRC_CODING_API uint32_t crc_compute(const uint8_t *buf, size_t len);
+
+// CRC of n buffers into out[0..n-1], short buffers are folded several at a time by the
+// ... multi-stream kernel, so a batch of packets is cheaper than n calls of crc_compute()
+CRC_CODING_API void crc_compute_many(const uint8_t *const *bufs, const size_t *lens, size_t n, uint32_t *out);
+
+// check n codewords, each one a payload followed by its CRC in big-endian bytes as crc_tx writes
+// ... them, accepted[i] is 1 if codeword i passes and 0 if not or if it is too short to hold a CRC
+CRC_CODING_API void crc_check_many(const uint8_t *const *bufs, const size_t *lens, size_t n, int *accepted);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,77 @@
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "crc_options.h"
+#include "thread_pool.h"
+#include "crc_weights.h"
+#include "crc_distance.h"
+
+// @brief:  print the number of undetectable error patterns of every weight up to max_weight for the
+//          ... codewords of message_length data bits and the Hamming distance of the generator
+// @params: GeneratorPolynomial generator
+//          size_t message_length
+//          int max_weight
+//          WorkStealingPool &pool
+// @return: void
+// @author: Donghan Xia, 2026/10/17
+void AnalyzeGenerator(const GeneratorPolynomial &generator, size_t message_length, int max_weight, WorkStealingPool &pool) {
+    size_t codeword_length = message_length + generator.degree;
+    auto start_time = std::chrono::steady_clock::now();
+    std::vector<uint64_t> weight_counts = CountUndetectablePatterns(BuildBitSyndromes(generator, codeword_length), max_weight, pool);
+    double elapsed_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+
+    std::cout << "generator: " << FormatGeneratorPolynomial(generator) << "  message bits: " << message_length
+            << "  codeword bits: " << codeword_length << "  threads: " << pool.GetThreadCount() << std::endl;
+    std::cout << "weight  undetectable patterns  all patterns  undetectable fraction" << std::endl;
+
+    int hamming_distance = 0;
+    double pattern_count = 1;
+    for (int error_weight = 1; error_weight <= max_weight; error_weight++) {
+        // binomial coefficient C(codeword_length, error_weight), as a double since it soon overflows
+        pattern_count = pattern_count * (codeword_length - error_weight + 1) / error_weight;
+
+        char row_data[128];
+        snprintf(row_data, sizeof(row_data), "%6d  %21llu  %12.6g  %.6e", error_weight,
+                (unsigned long long) weight_counts[error_weight], pattern_count,
+                pattern_count > 0 ? weight_counts[error_weight] / pattern_count : 0.0);
+        std::cout << row_data << std::endl;
+
+        if (hamming_distance == 0 && weight_counts[error_weight] > 0) {
+            hamming_distance = error_weight;
+        }
+    }
+
+    // every pattern up to max_weight is detected, so only a lower bound is known
+    if (hamming_distance == 0) {
+        std::cout << "hamming distance: > " << max_weight << std::endl;
+    } else {
+        std::cout << "hamming distance: " << hamming_distance << std::endl;
+    }
+    std::cout << "time: " << elapsed_seconds << " s" << std::endl;
+}
+
+int main(int argc, char *argv[]) {
+
+    CrcOptions options = ParseCrcOptions(argc, argv, CRC_DISTANCE_OPTIONS);
+
+    // the generator of the selected CRC algorithm unless one is given
+    GeneratorPolynomial generator;
+    if (!options.generator_data.empty()) {
+        if (!ParseGeneratorPolynomial(options.generator_data, generator)) {
+            std::cerr << "invalid generator polynomial: " << options.generator_data << std::endl;
+            PrintUsage(argv[0], CRC_DISTANCE_OPTIONS);
+            exit(EXIT_FAILURE);
+        }
+    } else {
+        FindAlgorithmGenerator(options.algorithm_name, generator);
+    }
+
+    // the enumeration uses every core unless -j is given
+    WorkStealingPool pool(options.has_thread_count ? options.thread_count : 0);
+    AnalyzeGenerator(generator, options.message_length, options.max_weight, pool);
+
+    return 0;
+}
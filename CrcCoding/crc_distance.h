@@ -0,0 +1,6 @@
+#include <cstddef>
+
+#include "thread_pool.h"
+#include "crc_weights.h"
+
+void AnalyzeGenerator(const GeneratorPolynomial &generator, size_t message_length, int max_weight, WorkStealingPool &pool);
\ No newline at end of file
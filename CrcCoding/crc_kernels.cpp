@@ -0,0 +1,375 @@
+#include <string>
+#include <immintrin.h>
+
+#include "crc_kernels.h"
+
+// reflected Castagnoli generator 0x1edc6f41
+#define CRC32C_REFLECTED_POLY 0x82f63b78
+// bytes per stream of the 3-way interleaved CRC-32C kernel
+#define CRC32C_LONG_STREAM_SIZE 8192
+#define CRC32C_SHORT_STREAM_SIZE 256
+
+// tables that multiply a 32-bit register by a fixed power of x, one table per register byte
+struct CrcShiftTables {
+    uint32_t shift[4][CRC_TABLE_SIZE];
+};
+
+// @brief:  fold a 128-bit accumulator forward and add the next block
+// @params: __m128i accumulator
+//          __m128i multiplier, folding constants of the two 64-bit lanes
+//          __m128i next_block
+// @return: __m128i, the folded accumulator
+// @author: Donghan Xia, 2026/10/17
+__attribute__((target("pclmul,sse4.1")))
+static inline __m128i FoldBlock(__m128i accumulator, __m128i multiplier, __m128i next_block) {
+    __m128i low_product = _mm_clmulepi64_si128(accumulator, multiplier, 0x00);
+    __m128i high_product = _mm_clmulepi64_si128(accumulator, multiplier, 0x11);
+    return _mm_xor_si128(_mm_xor_si128(low_product, high_product), next_block);
+}
+
+// @brief:  load one 16-byte block, a non-reflected block is byte-swapped so that its first byte
+//          ... holds the highest degree bits
+// @params: const uint8_t *block_data
+//          bool reflected
+// @return: __m128i
+// @author: Donghan Xia, 2026/10/17
+__attribute__((target("pclmul,sse4.1")))
+static inline __m128i LoadBlock(const uint8_t *block_data, bool reflected) {
+    const __m128i byte_reverse_mask = _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+    __m128i block = _mm_loadu_si128((const __m128i *) block_data);
+    return reflected ? block : _mm_shuffle_epi8(block, byte_reverse_mask);
+}
+
+// @brief:  carry-less multiply two values of at most 64 bits
+// @params: uint64_t first_value
+//          uint64_t second_value
+// @return: __m128i, the 128-bit product
+// @author: Donghan Xia, 2026/10/17
+__attribute__((target("pclmul,sse4.1")))
+static inline __m128i MultiplyCarryless(uint64_t first_value, uint64_t second_value) {
+    return _mm_clmulepi64_si128(_mm_cvtsi64_si128(first_value), _mm_cvtsi64_si128(second_value), 0x00);
+}
+
+// @brief:  reduce a non-reflected 128-bit block X to (X * x^32) mod P', which is the CRC register
+//          ... after the block has been shifted in
+//          X * x^32 is first folded to 96 bits with x^96 mod P', then to 64 bits with x^64 mod P',
+//          ... and the last 64-bit value is reduced by Barrett reduction
+// @params: uint64_t high_half, the coefficients of x^127 .. x^64
+//          uint64_t low_half, the coefficients of x^63 .. x^0
+//          CrcFoldConstants constants
+// @return: uint32_t, the 32-bit remainder
+// @author: Donghan Xia, 2026/10/17
+__attribute__((target("pclmul,sse4.1")))
+static uint32_t ReduceBlock(uint64_t high_half, uint64_t low_half, const CrcFoldConstants &constants) {
+    // 96-bit value: high_half * (x^96 mod P') + low_half * x^32
+    __m128i value_96 = MultiplyCarryless(high_half, constants.reduce_96);
+    value_96 = _mm_xor_si128(value_96, _mm_slli_si128(_mm_cvtsi64_si128(low_half), 4));
+
+    // 64-bit value: (top 32 bits) * (x^64 mod P') + low 64 bits
+    uint64_t top_32 = _mm_extract_epi64(value_96, 1);
+    uint64_t value_64 = _mm_cvtsi128_si64(MultiplyCarryless(top_32, constants.reduce_64))
+            ^ (uint64_t) _mm_cvtsi128_si64(value_96);
+
+    // Barrett reduction: quotient = floor(floor(value_64 / x^32) * mu / x^32)
+    uint64_t quotient = _mm_cvtsi128_si64(MultiplyCarryless(value_64 >> 32, constants.barrett_mu)) >> 32;
+    uint64_t product = _mm_cvtsi128_si64(MultiplyCarryless(quotient, constants.barrett_poly));
+
+    return (uint32_t) (value_64 ^ product);
+}
+
+// @brief:  reverse the order of all 64 bits at run time, a few masks instead of the bit loop of
+//          ... ReflectBits64(), which is meant for the constants built at compile time
+// @params: uint64_t value
+// @return: uint64_t
+// @author: Donghan Xia, 2026/10/17
+static inline uint64_t ReverseBits64(uint64_t value) {
+    value = __builtin_bswap64(value);
+    value = ((value >> 4) & 0x0f0f0f0f0f0f0f0f) | ((value & 0x0f0f0f0f0f0f0f0f) << 4);
+    value = ((value >> 2) & 0x3333333333333333) | ((value & 0x3333333333333333) << 2);
+    return ((value >> 1) & 0x5555555555555555) | ((value & 0x5555555555555555) << 1);
+}
+
+// @brief:  reduce the folded block to the CRC register, the whole reflected block is reversed once
+//          ... to share the non-reflected reduction
+// @params: __m128i folded
+//          CrcFoldConstants constants
+// @return: uint32_t, internal register
+// @author: Donghan Xia, 2026/10/17
+__attribute__((target("pclmul,sse4.1")))
+static inline uint32_t ReduceFoldedBlock(__m128i folded, const CrcFoldConstants &constants) {
+    uint64_t low_lane = _mm_cvtsi128_si64(folded);
+    uint64_t high_lane = _mm_extract_epi64(folded, 1);
+    if (!constants.reflected) {
+        return ReduceBlock(high_lane, low_lane, constants);
+    }
+    uint32_t remainder = ReduceBlock(ReverseBits64(low_lane), ReverseBits64(high_lane), constants);
+    return ReverseBits64(remainder) >> 32;
+}
+
+// @brief:  fold 64 bytes per iteration with four independent 128-bit accumulators, then fold the
+//          ... accumulators and the remaining blocks into one and reduce it to the CRC register
+// @params: uint32_t crc_register, internal register
+//          const uint8_t *data
+//          size_t block_count, number of 16-byte blocks, at least 4
+//          CrcFoldConstants constants
+// @return: uint32_t, updated internal register
+// @author: Donghan Xia, 2026/10/17
+__attribute__((target("pclmul,sse4.1")))
+static uint32_t FoldPclmul(
+    uint32_t crc_register,
+    const uint8_t *data,
+    size_t block_count,
+    const CrcFoldConstants &constants) {
+
+    const bool reflected = constants.reflected;
+
+    __m128i accumulator[4];
+    for (int lane_index = 0; lane_index < 4; lane_index++) {
+        accumulator[lane_index] = LoadBlock(data + lane_index * CRC_FOLD_BLOCK_SIZE, reflected);
+    }
+    // the register is added to the highest degree bits of the first block
+    __m128i initial_register = reflected
+            ? _mm_cvtsi32_si128(crc_register)
+            : _mm_slli_si128(_mm_cvtsi32_si128(crc_register), 12);
+    accumulator[0] = _mm_xor_si128(accumulator[0], initial_register);
+    data += 4 * CRC_FOLD_BLOCK_SIZE;
+    block_count -= 4;
+
+    const __m128i fold_4_blocks = _mm_loadu_si128((const __m128i *) constants.fold_4_blocks);
+    while (block_count >= 4) {
+        for (int lane_index = 0; lane_index < 4; lane_index++) {
+            __m128i next_block = LoadBlock(data + lane_index * CRC_FOLD_BLOCK_SIZE, reflected);
+            accumulator[lane_index] = FoldBlock(accumulator[lane_index], fold_4_blocks, next_block);
+        }
+        data += 4 * CRC_FOLD_BLOCK_SIZE;
+        block_count -= 4;
+    }
+
+    const __m128i fold_1_block = _mm_loadu_si128((const __m128i *) constants.fold_1_block);
+    __m128i folded = accumulator[0];
+    for (int lane_index = 1; lane_index < 4; lane_index++) {
+        folded = FoldBlock(folded, fold_1_block, accumulator[lane_index]);
+    }
+    while (block_count > 0) {
+        folded = FoldBlock(folded, fold_1_block, LoadBlock(data, reflected));
+        data += CRC_FOLD_BLOCK_SIZE;
+        block_count--;
+    }
+
+    return ReduceFoldedBlock(folded, constants);
+}
+
+// @brief:  multiply two reflected CRC-32C registers modulo the Castagnoli generator
+// @params: uint32_t first_value
+//          uint32_t second_value
+// @return: uint32_t, reflected product
+// @author: Donghan Xia, 2026/10/17
+static constexpr uint32_t MultiplyModCrc32c(uint32_t first_value, uint32_t second_value) {
+    uint32_t product = 0;
+    // the highest bit of a reflected register is the coefficient of x^0
+    for (uint32_t mask = (uint32_t) 1 << 31; mask != 0; mask >>= 1) {
+        if (first_value & mask) {
+            product ^= second_value;
+        }
+        second_value = (second_value & 1) ? (second_value >> 1) ^ CRC32C_REFLECTED_POLY : second_value >> 1;
+    }
+    return product;
+}
+
+// @brief:  build the tables that shift a CRC-32C register over byte_count zero bytes, one table per
+//          ... register byte, so a shift costs four lookups instead of byte_count crc32 instructions
+// @params: size_t byte_count
+// @return: CrcShiftTables
+// @author: Donghan Xia, 2026/10/17
+static constexpr CrcShiftTables BuildCrc32cShiftTables(size_t byte_count) {
+    // x^(8 * byte_count) mod P in reflected form, starting from x^0
+    uint32_t shift_power = (uint32_t) 1 << 31;
+    for (size_t bit_index = 0; bit_index < 8 * byte_count; bit_index++) {
+        shift_power = (shift_power & 1) ? (shift_power >> 1) ^ CRC32C_REFLECTED_POLY : shift_power >> 1;
+    }
+
+    CrcShiftTables tables = {};
+    for (int byte_index = 0; byte_index < 4; byte_index++) {
+        for (int byte_value = 0; byte_value < CRC_TABLE_SIZE; byte_value++) {
+            tables.shift[byte_index][byte_value]
+                    = MultiplyModCrc32c((uint32_t) byte_value << (8 * byte_index), shift_power);
+        }
+    }
+    return tables;
+}
+
+static constexpr CrcShiftTables crc32c_long_shift = BuildCrc32cShiftTables(CRC32C_LONG_STREAM_SIZE);
+static constexpr CrcShiftTables crc32c_short_shift = BuildCrc32cShiftTables(CRC32C_SHORT_STREAM_SIZE);
+
+// @brief:  shift a CRC-32C register over the zero bytes that the tables were built for
+// @params: uint32_t crc_register
+//          CrcShiftTables tables
+// @return: uint32_t
+// @author: Donghan Xia, 2026/10/17
+static inline uint32_t ShiftCrc32c(uint32_t crc_register, const CrcShiftTables &tables) {
+    return tables.shift[0][crc_register & 0xff]
+            ^ tables.shift[1][(crc_register >> 8) & 0xff]
+            ^ tables.shift[2][(crc_register >> 16) & 0xff]
+            ^ tables.shift[3][crc_register >> 24];
+}
+
+// @brief:  run the crc32 instruction over three adjacent streams of stream_size bytes at the same
+//          ... time, so the three independent dependency chains hide the instruction latency
+//          the stream registers are then combined: crc(A B C) = shift(shift(crc(A), |B|) ^ crc(B), |C|) ^ crc(C)
+//          ... where crc(B) and crc(C) start from a zero register
+// @params: uint32_t crc_register, reflected register before the first stream
+//          const uint8_t *data
+//          size_t stream_size, bytes per stream, a multiple of 8
+//          CrcShiftTables shift_tables, tables for shifting over stream_size zero bytes
+// @return: uint32_t, reflected register after the third stream
+// @author: Donghan Xia, 2026/10/17
+__attribute__((target("sse4.2")))
+static inline uint32_t UpdateCrc32cThreeStreams(
+    uint32_t crc_register,
+    const uint8_t *data,
+    size_t stream_size,
+    const CrcShiftTables &shift_tables) {
+
+    uint64_t first_crc = crc_register;
+    uint64_t second_crc = 0;
+    uint64_t third_crc = 0;
+    for (size_t offset = 0; offset < stream_size; offset += 8) {
+        uint64_t first_word, second_word, third_word;
+        __builtin_memcpy(&first_word, data + offset, 8);
+        __builtin_memcpy(&second_word, data + stream_size + offset, 8);
+        __builtin_memcpy(&third_word, data + 2 * stream_size + offset, 8);
+        first_crc = _mm_crc32_u64(first_crc, first_word);
+        second_crc = _mm_crc32_u64(second_crc, second_word);
+        third_crc = _mm_crc32_u64(third_crc, third_word);
+    }
+
+    uint32_t combined = ShiftCrc32c(first_crc, shift_tables) ^ second_crc;
+    return ShiftCrc32c(combined, shift_tables) ^ third_crc;
+}
+
+// @brief:  shift bytes into the reflected CRC-32C register with the crc32 instruction
+//          large buffers are split into three interleaved streams of 8 KB, then of 256 bytes, and the
+//          ... rest is handled by a single stream
+// @params: uint32_t crc_register, internal register
+//          const uint8_t *data
+//          size_t size, number of bytes
+// @return: uint32_t, updated internal register
+// @author: Donghan Xia, 2026/10/17
+__attribute__((target("sse4.2")))
+static uint32_t UpdateCrc32cSse42(uint32_t crc_register, const uint8_t *data, size_t size) {
+    while (size >= 3 * CRC32C_LONG_STREAM_SIZE) {
+        crc_register = UpdateCrc32cThreeStreams(crc_register, data, CRC32C_LONG_STREAM_SIZE, crc32c_long_shift);
+        data += 3 * CRC32C_LONG_STREAM_SIZE;
+        size -= 3 * CRC32C_LONG_STREAM_SIZE;
+    }
+    while (size >= 3 * CRC32C_SHORT_STREAM_SIZE) {
+        crc_register = UpdateCrc32cThreeStreams(crc_register, data, CRC32C_SHORT_STREAM_SIZE, crc32c_short_shift);
+        data += 3 * CRC32C_SHORT_STREAM_SIZE;
+        size -= 3 * CRC32C_SHORT_STREAM_SIZE;
+    }
+
+    uint64_t crc_value = crc_register;
+    while (size >= 8) {
+        uint64_t word;
+        __builtin_memcpy(&word, data, sizeof(word));
+        crc_value = _mm_crc32_u64(crc_value, word);
+        data += 8;
+        size -= 8;
+    }
+    while (size > 0) {
+        crc_value = _mm_crc32_u8(crc_value, *data);
+        data++;
+        size--;
+    }
+
+    return crc_value;
+}
+
+// @brief:  fold the leading blocks of CRC_MULTI_STREAM_COUNT messages side by side
+//          a single short message is bound by the latency of each fold, which needs the previous
+//          ... one, while the folds of different messages are independent, so interleaving the
+//          ... messages block by block keeps the carry-less multiplier busy and needs no lookup
+//          ... table at all
+// @params: uint32_t *crc_registers, the internal register of every message, updated in place
+//          const uint8_t *const *data, the first byte of every message
+//          size_t block_count, number of 16-byte blocks of every message, at least 1
+//          CrcFoldConstants constants
+// @return: void
+// @author: Donghan Xia, 2026/10/17
+__attribute__((target("pclmul,sse4.1")))
+static void FoldMultiStreamPclmul(
+    uint32_t *crc_registers,
+    const uint8_t *const *data,
+    size_t block_count,
+    const CrcFoldConstants &constants) {
+
+    const bool reflected = constants.reflected;
+
+    __m128i accumulator[CRC_MULTI_STREAM_COUNT];
+    for (int stream_index = 0; stream_index < CRC_MULTI_STREAM_COUNT; stream_index++) {
+        // the register is added to the highest degree bits of the first block
+        __m128i initial_register = reflected
+                ? _mm_cvtsi32_si128(crc_registers[stream_index])
+                : _mm_slli_si128(_mm_cvtsi32_si128(crc_registers[stream_index]), 12);
+        accumulator[stream_index] = _mm_xor_si128(LoadBlock(data[stream_index], reflected), initial_register);
+    }
+
+    const __m128i fold_1_block = _mm_loadu_si128((const __m128i *) constants.fold_1_block);
+    for (size_t block_index = 1; block_index < block_count; block_index++) {
+        size_t block_offset = block_index * CRC_FOLD_BLOCK_SIZE;
+        for (int stream_index = 0; stream_index < CRC_MULTI_STREAM_COUNT; stream_index++) {
+            __m128i next_block = LoadBlock(data[stream_index] + block_offset, reflected);
+            accumulator[stream_index] = FoldBlock(accumulator[stream_index], fold_1_block, next_block);
+        }
+    }
+
+    for (int stream_index = 0; stream_index < CRC_MULTI_STREAM_COUNT; stream_index++) {
+        crc_registers[stream_index] = ReduceFoldedBlock(accumulator[stream_index], constants);
+    }
+}
+
+// @brief:  choose the fastest kernels supported by the CPU according to CPUID
+// @params: void
+// @return: CrcKernelDispatch
+// @author: Donghan Xia, 2026/10/17
+static CrcKernelDispatch DetectCrcKernels() {
+    CrcKernelDispatch dispatch = {nullptr, nullptr, nullptr};
+
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("pclmul") && __builtin_cpu_supports("sse4.1")) {
+        dispatch.fold = FoldPclmul;
+        dispatch.multi_fold = FoldMultiStreamPclmul;
+    }
+    if (__builtin_cpu_supports("sse4.2")) {
+        dispatch.crc32c = UpdateCrc32cSse42;
+    }
+
+    return dispatch;
+}
+
+// kernels selected once at program startup
+CrcKernelDispatch crc_kernel_dispatch = DetectCrcKernels();
+
+// @brief:  restrict the kernels used by the Crc template, mainly for comparing kernels
+//          "auto" keeps everything the CPU supports, "table" disables all hardware kernels,
+//          ... "pclmul" and "sse42" keep only that kernel
+// @params: std::string kernel_name
+// @return: bool, false if the name is unknown or the CPU does not support the kernel
+// @author: Donghan Xia, 2026/10/17
+bool SelectCrcKernel(const std::string &kernel_name) {
+    CrcKernelDispatch detected = DetectCrcKernels();
+
+    if (kernel_name == "auto") {
+        crc_kernel_dispatch = detected;
+    } else if (kernel_name == "table") {
+        crc_kernel_dispatch = {nullptr, nullptr, nullptr};
+    } else if (kernel_name == "pclmul" && detected.fold != nullptr) {
+        crc_kernel_dispatch = {detected.fold, nullptr, detected.multi_fold};
+    } else if (kernel_name == "sse42" && detected.crc32c != nullptr) {
+        crc_kernel_dispatch = {nullptr, detected.crc32c, nullptr};
+    } else {
+        return false;
+    }
+
+    return true;
+}
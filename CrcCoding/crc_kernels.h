@@ -0,0 +1,157 @@
+#ifndef CRC_KERNELS_H
+#define CRC_KERNELS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// number of lookup tables used by the slicing-by-8 CRC update
+#define CRC_SLICE_COUNT 8
+// number of entries in each lookup table, one entry per byte value
+#define CRC_TABLE_SIZE 256
+// size of one 128-bit folding block in bytes
+#define CRC_FOLD_BLOCK_SIZE 16
+// smallest buffer handed to the folding kernel, shorter buffers stay on the lookup tables
+#define CRC_FOLD_MIN_SIZE 128
+// number of messages folded side by side by the multi-stream kernel
+#define CRC_MULTI_STREAM_COUNT 16
+// fewest blocks per message worth the multi-stream kernel, a single block is reduced right after
+// ... it is loaded and the lookup tables are faster for it
+#define CRC_MULTI_FOLD_MIN_BLOCKS 2
+
+// constants of the carry-less multiplication folding for one generator
+// every generator of width 8 to 32 is scaled to the 33-bit generator P' = P * x^(32 - width), whose
+// ... remainder is the CRC register in its internal 32-bit form (see crc_template.h)
+struct CrcFoldConstants {
+    // multipliers for folding 4 blocks (512 bits) ahead, one per 64-bit lane
+    uint64_t fold_4_blocks[2];
+    // multipliers for folding 1 block (128 bits) ahead, one per 64-bit lane
+    uint64_t fold_1_block[2];
+    // x^96 mod P' and x^64 mod P', reduce the last 128-bit block down to 64 bits
+    uint64_t reduce_96;
+    uint64_t reduce_64;
+    // Barrett reduction constants: floor(x^64 / P') and P' itself
+    uint64_t barrett_mu;
+    uint64_t barrett_poly;
+    // whether the data bits are processed starting from the least significant bit of each byte
+    bool reflected;
+};
+
+// fold block_count (at least 4) 16-byte blocks into the internal CRC register
+typedef uint32_t (*CrcFoldFunc)(
+    uint32_t crc_register,
+    const uint8_t *data,
+    size_t block_count,
+    const CrcFoldConstants &constants
+);
+
+// fold block_count (at least 1) 16-byte blocks of each of CRC_MULTI_STREAM_COUNT messages into
+// ... their internal CRC registers
+typedef void (*CrcMultiFoldFunc)(
+    uint32_t *crc_registers,
+    const uint8_t *const *data,
+    size_t block_count,
+    const CrcFoldConstants &constants
+);
+
+// shift size bytes into the reflected CRC-32C register with the SSE4.2 crc32 instruction
+typedef uint32_t (*Crc32cFunc)(uint32_t crc_register, const uint8_t *data, size_t size);
+
+// kernels selected by CPUID at startup, a null pointer means the CPU cannot run that kernel
+// ... and the portable lookup tables are used instead
+struct CrcKernelDispatch {
+    CrcFoldFunc fold;
+    Crc32cFunc crc32c;
+    CrcMultiFoldFunc multi_fold;
+};
+
+extern CrcKernelDispatch crc_kernel_dispatch;
+
+bool SelectCrcKernel(const std::string &kernel_name);
+
+// @brief:  calculate x^exponent mod P' for a 33-bit generator
+// @params: int exponent
+//          uint64_t full_poly, the generator including its x^32 term
+// @return: uint64_t, remainder of degree below 32
+// @author: Donghan Xia, 2026/10/17
+constexpr uint64_t PowerModPoly(int exponent, uint64_t full_poly) {
+    uint64_t remainder = 1;
+    for (int power = 0; power < exponent; power++) {
+        remainder <<= 1;
+        if ((remainder >> 32) & 1) {
+            remainder ^= full_poly;
+        }
+    }
+    return remainder;
+}
+
+// @brief:  calculate floor(x^64 / P') by mod 2 long division
+// @params: uint64_t full_poly, the generator including its x^32 term
+// @return: uint64_t, 33-bit quotient
+// @author: Donghan Xia, 2026/10/17
+constexpr uint64_t DivideX64ByPoly(uint64_t full_poly) {
+    uint64_t quotient = 0;
+    // 33-bit window over the dividend, its top bit is the coefficient of x^degree
+    uint64_t window = (uint64_t) 1 << 32;
+    for (int degree = 64; degree >= 32; degree--) {
+        if ((window >> 32) & 1) {
+            quotient |= (uint64_t) 1 << (degree - 32);
+            window ^= full_poly;
+        }
+        window <<= 1;
+    }
+    return quotient;
+}
+
+// @brief:  reverse the order of all 64 bits
+// @params: uint64_t value
+// @return: uint64_t
+// @author: Donghan Xia, 2026/10/17
+constexpr uint64_t ReflectBits64(uint64_t value) {
+    uint64_t result = 0;
+    for (int bit_index = 0; bit_index < 64; bit_index++) {
+        result = (result << 1) | ((value >> bit_index) & 1);
+    }
+    return result;
+}
+
+// @brief:  build the folding constants of a generator at compile time
+//          the multiplier of a non-reflected fold over n bits is x^n mod P', a reflected fold uses
+//          ... the bit-reversed x^(n-1) mod P' because the carry-less product of two reversed
+//          ... operands comes out one bit short of the reversed product
+// @params: bool reflected
+//          uint32_t register_poly, generator in the internal register form
+// @return: CrcFoldConstants
+// @author: Donghan Xia, 2026/10/17
+constexpr CrcFoldConstants BuildCrcFoldConstants(bool reflected, uint32_t register_poly) {
+    uint64_t poly = register_poly;
+    if (reflected) {
+        poly = ReflectBits64(poly) >> 32;
+    }
+    uint64_t full_poly = ((uint64_t) 1 << 32) | poly;
+
+    CrcFoldConstants constants = {};
+    if (reflected) {
+        // lane 0 holds the high-degree half of a reflected block
+        constants.fold_4_blocks[0] = ReflectBits64(PowerModPoly(512 + 64 - 1, full_poly));
+        constants.fold_4_blocks[1] = ReflectBits64(PowerModPoly(512 - 1, full_poly));
+        constants.fold_1_block[0] = ReflectBits64(PowerModPoly(128 + 64 - 1, full_poly));
+        constants.fold_1_block[1] = ReflectBits64(PowerModPoly(128 - 1, full_poly));
+    } else {
+        // lane 1 holds the high-degree half of a byte-swapped block
+        constants.fold_4_blocks[0] = PowerModPoly(512, full_poly);
+        constants.fold_4_blocks[1] = PowerModPoly(512 + 64, full_poly);
+        constants.fold_1_block[0] = PowerModPoly(128, full_poly);
+        constants.fold_1_block[1] = PowerModPoly(128 + 64, full_poly);
+    }
+    // the final reduction always runs on the non-reflected form of the last block
+    constants.reduce_96 = PowerModPoly(96, full_poly);
+    constants.reduce_64 = PowerModPoly(64, full_poly);
+    constants.barrett_mu = DivideX64ByPoly(full_poly);
+    constants.barrett_poly = full_poly;
+    constants.reflected = reflected;
+
+    return constants;
+}
+
+#endif
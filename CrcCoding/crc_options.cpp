@@ -0,0 +1,334 @@
+#include <algorithm>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <cstdlib>
+
+#include "crc_template.h"
+#include "crc_options.h"
+
+// long name of every option by its short letter
+static const std::pair<char, const char *> kLongOptionNames[] = {
+    {'a', "--algorithm"}, {'k', "--kernel"}, {'j', "--threads"}, {'b', "--batch"}, {'c', "--checksum"},
+    {'w', "--checksum-width"}, {'n', "--trials"}, {'e', "--errors"}, {'q', "--arq"}, {'R', "--link-rate"},
+    {'D', "--delay"}, {'l', "--length"}, {'s', "--seed"}, {'g', "--generator"}, {'m', "--max-weight"},
+    {'d', "--degree"}, {'f', "--filter"}, {'t', "--top"}, {'x', "--correct"}, {'i', "--input"},
+    {'r', "--record-size"}, {'F', "--framed"}, {'o', "--output"}, {'O', "--output-file"}, {'p', "--profile"}
+};
+
+// @brief:  get the short letter of a short or long option
+// @params: std::string arg
+// @return: char, '\0' if arg is no option
+// @author: Donghan Xia, 2026/10/17
+static char GetOptionLetter(const std::string &arg) {
+    if (arg.size() == 2 && arg[0] == '-' && arg[1] != '-') {
+        return arg[1];
+    }
+    for (const auto &long_option_name : kLongOptionNames) {
+        if (arg == long_option_name.second) {
+            return long_option_name.first;
+        }
+    }
+    return '\0';
+}
+
+// @brief:  parse the command line options, print the usage and exit if any option is invalid or
+//          ... not one of the program
+// @params: int argc
+//          char *argv[]
+//          std::string program_options, short letters of the options of the program, e.g.
+//          ... CRC_TX_OPTIONS
+// @return: CrcOptions
+// @author: Donghan Xia, 2026/10/17
+CrcOptions ParseCrcOptions(int argc, char *argv[], const std::string &program_options) {
+    CrcOptions options;
+
+    for (int arg_index = 1; arg_index < argc; arg_index++) {
+        std::string arg = argv[arg_index];
+        // every option except the flags takes exactly one value
+        bool has_value = arg_index + 1 < argc;
+
+        char option_letter = GetOptionLetter(arg);
+        if (option_letter == '\0' || program_options.find(option_letter) == std::string::npos) {
+            if (arg != "-h" && arg != "--help") {
+                std::cerr << "unknown option: " << arg << std::endl;
+            }
+            PrintUsage(argv[0], program_options);
+            exit(EXIT_FAILURE);
+        }
+
+        if ((arg == "-a" || arg == "--algorithm") && has_value) {
+            options.algorithm_name = argv[++arg_index];
+        } else if ((arg == "-k" || arg == "--kernel") && has_value) {
+            options.kernel_name = argv[++arg_index];
+        } else if ((arg == "-j" || arg == "--threads") && has_value) {
+            char *value_end = nullptr;
+            options.thread_count = strtol(argv[++arg_index], &value_end, 10);
+            if (*value_end != '\0' || options.thread_count < 0) {
+                std::cerr << "invalid thread count: " << argv[arg_index] << std::endl;
+                PrintUsage(argv[0], program_options);
+                exit(EXIT_FAILURE);
+            }
+            options.has_thread_count = true;
+        } else if ((arg == "-b" || arg == "--batch") && has_value) {
+            char *value_end = nullptr;
+            options.batch_line_count = strtol(argv[++arg_index], &value_end, 10);
+            if (*value_end != '\0' || options.batch_line_count < 0) {
+                std::cerr << "invalid batch line count: " << argv[arg_index] << std::endl;
+                PrintUsage(argv[0], program_options);
+                exit(EXIT_FAILURE);
+            }
+        } else if ((arg == "-c" || arg == "--checksum") && has_value) {
+            options.checksum_name = argv[++arg_index];
+        } else if ((arg == "-w" || arg == "--checksum-width") && has_value) {
+            char *value_end = nullptr;
+            options.checksum_width = strtol(argv[++arg_index], &value_end, 10);
+            if (*value_end != '\0' || !IsChecksumWidthSupported(options.checksum_width)) {
+                std::cerr << "invalid checksum width: " << argv[arg_index] << std::endl;
+                PrintUsage(argv[0], program_options);
+                exit(EXIT_FAILURE);
+            }
+        } else if ((arg == "-n" || arg == "--trials") && has_value) {
+            char *value_end = nullptr;
+            options.trial_count = strtoull(argv[++arg_index], &value_end, 10);
+            if (*value_end != '\0' || argv[arg_index][0] == '-') {
+                std::cerr << "invalid trial count: " << argv[arg_index] << std::endl;
+                PrintUsage(argv[0], program_options);
+                exit(EXIT_FAILURE);
+            }
+        } else if ((arg == "-e" || arg == "--errors") && has_value) {
+            // one channel model or a comma-separated list of models
+            std::string model_list = argv[++arg_index];
+            options.error_model_names.clear();
+            for (size_t model_begin = 0; model_begin <= model_list.size();) {
+                size_t model_end = std::min(model_list.find(',', model_begin), model_list.size());
+                options.error_model_names.push_back(model_list.substr(model_begin, model_end - model_begin));
+                model_begin = model_end + 1;
+            }
+            options.error_model_name = options.error_model_names[0];
+        } else if ((arg == "-q" || arg == "--arq") && has_value) {
+            options.arq_protocol_name = argv[++arg_index];
+        } else if ((arg == "-R" || arg == "--link-rate") && has_value) {
+            char *value_end = nullptr;
+            options.link_bit_rate = strtod(argv[++arg_index], &value_end);
+            if (*value_end != '\0' || !(options.link_bit_rate > 0)) {
+                std::cerr << "invalid link rate: " << argv[arg_index] << std::endl;
+                PrintUsage(argv[0], program_options);
+                exit(EXIT_FAILURE);
+            }
+        } else if ((arg == "-D" || arg == "--delay") && has_value) {
+            char *value_end = nullptr;
+            options.link_delay = strtod(argv[++arg_index], &value_end);
+            if (*value_end != '\0' || !(options.link_delay >= 0)) {
+                std::cerr << "invalid link delay: " << argv[arg_index] << std::endl;
+                PrintUsage(argv[0], program_options);
+                exit(EXIT_FAILURE);
+            }
+        } else if ((arg == "-l" || arg == "--length") && has_value) {
+            // one length or a comma-separated list of lengths
+            char *value_end = argv[++arg_index] - 1;
+            options.message_lengths.clear();
+            do {
+                long message_length = strtol(value_end + 1, &value_end, 10);
+                if (message_length < 1 || (*value_end != ',' && *value_end != '\0')) {
+                    std::cerr << "invalid message length: " << argv[arg_index] << std::endl;
+                    PrintUsage(argv[0], program_options);
+                    exit(EXIT_FAILURE);
+                }
+                options.message_lengths.push_back(message_length);
+            } while (*value_end == ',');
+            options.message_length = options.message_lengths[0];
+        } else if ((arg == "-s" || arg == "--seed") && has_value) {
+            char *value_end = nullptr;
+            options.seed = strtoull(argv[++arg_index], &value_end, 10);
+            if (*value_end != '\0') {
+                std::cerr << "invalid seed: " << argv[arg_index] << std::endl;
+                PrintUsage(argv[0], program_options);
+                exit(EXIT_FAILURE);
+            }
+        } else if ((arg == "-g" || arg == "--generator") && has_value) {
+            options.generator_data = argv[++arg_index];
+        } else if ((arg == "-m" || arg == "--max-weight") && has_value) {
+            char *value_end = nullptr;
+            options.max_weight = strtol(argv[++arg_index], &value_end, 10);
+            if (*value_end != '\0' || options.max_weight < 1) {
+                std::cerr << "invalid max weight: " << argv[arg_index] << std::endl;
+                PrintUsage(argv[0], program_options);
+                exit(EXIT_FAILURE);
+            }
+        } else if ((arg == "-d" || arg == "--degree") && has_value) {
+            char *value_end = nullptr;
+            options.generator_degree = strtol(argv[++arg_index], &value_end, 10);
+            if (*value_end != '\0' || options.generator_degree < 1 || options.generator_degree > MAX_SEARCH_DEGREE) {
+                std::cerr << "invalid generator degree: " << argv[arg_index] << std::endl;
+                PrintUsage(argv[0], program_options);
+                exit(EXIT_FAILURE);
+            }
+        } else if ((arg == "-f" || arg == "--filter") && has_value) {
+            options.generator_filter = argv[++arg_index];
+            if (options.generator_filter != "all" && options.generator_filter != "x+1") {
+                std::cerr << "invalid generator filter: " << argv[arg_index] << std::endl;
+                PrintUsage(argv[0], program_options);
+                exit(EXIT_FAILURE);
+            }
+        } else if ((arg == "-t" || arg == "--top") && has_value) {
+            char *value_end = nullptr;
+            options.top_count = strtol(argv[++arg_index], &value_end, 10);
+            if (*value_end != '\0' || options.top_count < 1) {
+                std::cerr << "invalid top count: " << argv[arg_index] << std::endl;
+                PrintUsage(argv[0], program_options);
+                exit(EXIT_FAILURE);
+            }
+        } else if ((arg == "-x" || arg == "--correct") && has_value) {
+            char *value_end = nullptr;
+            options.correction_weight = strtol(argv[++arg_index], &value_end, 10);
+            if (*value_end != '\0' || options.correction_weight < 0 || options.correction_weight > 2) {
+                std::cerr << "invalid correction weight: " << argv[arg_index] << std::endl;
+                PrintUsage(argv[0], program_options);
+                exit(EXIT_FAILURE);
+            }
+        } else if ((arg == "-i" || arg == "--input") && has_value) {
+            options.input_name = argv[++arg_index];
+        } else if ((arg == "-r" || arg == "--record-size") && has_value) {
+            char *value_end = nullptr;
+            options.record_size = strtoull(argv[++arg_index], &value_end, 10);
+            if (*value_end != '\0' || argv[arg_index][0] == '-') {
+                std::cerr << "invalid record size: " << argv[arg_index] << std::endl;
+                PrintUsage(argv[0], program_options);
+                exit(EXIT_FAILURE);
+            }
+        } else if (arg == "-F" || arg == "--framed") {
+            options.is_framed = true;
+        } else if ((arg == "-o" || arg == "--output") && has_value) {
+            options.result_mode_name = argv[++arg_index];
+        } else if ((arg == "-O" || arg == "--output-file") && has_value) {
+            options.result_output_name = argv[++arg_index];
+        } else if (arg == "-p" || arg == "--profile") {
+            options.is_profiling = true;
+        } else {
+            PrintUsage(argv[0], program_options);
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    // make sure the algorithm name can be dispatched before any data is read
+    if (!DispatchCrcAlgorithm(options.algorithm_name, [](auto) {})) {
+        std::cerr << "unknown CRC algorithm: " << options.algorithm_name << std::endl;
+        PrintUsage(argv[0], program_options);
+        exit(EXIT_FAILURE);
+    }
+
+    ChecksumAlgorithm checksum_algorithm;
+    if (!FindChecksumAlgorithm(options.checksum_name, options.checksum_width, checksum_algorithm)) {
+        std::cerr << "unknown checksum algorithm: " << options.checksum_name << std::endl;
+        PrintUsage(argv[0], program_options);
+        exit(EXIT_FAILURE);
+    }
+
+    for (const std::string &error_model_name : options.error_model_names) {
+        ErrorModel error_model;
+        if (!ParseErrorModel(error_model_name, error_model)) {
+            std::cerr << "invalid error model: " << error_model_name << std::endl;
+            PrintUsage(argv[0], program_options);
+            exit(EXIT_FAILURE);
+        }
+        // every frame of a weight or burst model has errors, so no frame would ever get through
+        if (!options.arq_protocol_name.empty() && error_model.kind != ErrorModel::BERNOULLI) {
+            std::cerr << "the ARQ mode needs ber:<probability> error models: " << error_model_name << std::endl;
+            PrintUsage(argv[0], program_options);
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    ArqProtocol arq_protocol;
+    if (!options.arq_protocol_name.empty() && !ParseArqProtocol(options.arq_protocol_name, arq_protocol)) {
+        std::cerr << "invalid ARQ protocol: " << options.arq_protocol_name << std::endl;
+        PrintUsage(argv[0], program_options);
+        exit(EXIT_FAILURE);
+    }
+
+    ResultWriter::Mode result_mode;
+    if (!ParseResultMode(options.result_mode_name, result_mode)) {
+        std::cerr << "unknown output mode: " << options.result_mode_name << std::endl;
+        PrintUsage(argv[0], program_options);
+        exit(EXIT_FAILURE);
+    }
+
+    if (!SelectCrcKernel(options.kernel_name)) {
+        std::cerr << "CRC kernel is unknown or not supported by this CPU: " << options.kernel_name << std::endl;
+        PrintUsage(argv[0], program_options);
+        exit(EXIT_FAILURE);
+    }
+
+    return options;
+}
+
+// @brief:  print the command line usage of the options of a program to stderr
+// @params: const char *program_name
+//          std::string program_options, short letters of the options of the program
+// @return: void
+// @author: Donghan Xia, 2026/10/17
+void PrintUsage(const char *program_name, const std::string &program_options) {
+    // one line per option, each starting with "  -<letter>,"
+    std::ostringstream usage_data;
+    usage_data << "  -a, --algorithm <name>  CRC algorithm: crc8, crc12, crc16, crc32, crc32c"
+            << " (default: " << DEFAULT_CRC_ALGORITHM << ")" << std::endl
+            << "  -k, --kernel <name>     CRC kernel: auto, table, pclmul, sse42"
+            << " (default: " << DEFAULT_CRC_KERNEL << ")" << std::endl
+            << "  -j, --threads <count>   threads for large records, 0 for one per core"
+            << " (default: " << DEFAULT_THREAD_COUNT << ")" << std::endl
+            << "  -b, --batch <lines>     crc_tx pipeline mode with batches of this many lines, 0 for off"
+            << " (default: " << DEFAULT_BATCH_LINE_COUNT << ")" << std::endl
+            << "  -c, --checksum <name>   crc_vs_checksum checksum: ones, fletcher16, fletcher32, adler32"
+            << " (default: " << DEFAULT_CHECKSUM_ALGORITHM << ")" << std::endl
+            << "  -w, --checksum-width <bits>  word width of the ones checksum: 8, 16, 32"
+            << " (default: " << DEFAULT_CHECKSUM_WIDTH << ")" << std::endl
+            << "  -n, --trials <count>    crc_vs_checksum Monte Carlo mode with this many random trials, 0 for off,"
+            << " or payloads per ARQ grid point (default: 0, " << DEFAULT_ARQ_FRAME_COUNT << " for ARQ)" << std::endl
+            << "  -e, --errors <model>[,<model>...]  Monte Carlo channel: ber:<probability>, weight:<bits>, burst:<bits>,"
+            << " the ARQ mode sweeps all, the others use the first"
+            << " (default: " << DEFAULT_ERROR_MODEL << ")" << std::endl
+            << "  -q, --arq <protocol>    crc_vs_checksum ARQ mode: saw, gbn:<window>, sr:<window>"
+            << " (default: off)" << std::endl
+            << "  -R, --link-rate <bits/s>  ARQ mode link rate"
+            << " (default: " << DEFAULT_ARQ_LINK_RATE << ")" << std::endl
+            << "  -D, --delay <seconds>   ARQ mode one-way propagation delay"
+            << " (default: " << DEFAULT_ARQ_LINK_DELAY << ")" << std::endl
+            << "  -l, --length <bits>[,<bits>...]  message lengths, crc_search ranks at all, the others use the first"
+            << " (default: " << DEFAULT_MONTE_CARLO_LENGTH << ")" << std::endl
+            << "  -s, --seed <number>     Monte Carlo seed"
+            << " (default: " << DEFAULT_MONTE_CARLO_SEED << ")" << std::endl
+            << "  -g, --generator <bits>  crc_distance generator, e.g. 1100000001111"
+            << " (default: the generator of the algorithm)" << std::endl
+            << "  -m, --max-weight <bits> crc_distance and crc_search highest error weight"
+            << " (default: " << DEFAULT_MAX_WEIGHT << ")" << std::endl
+            << "  -d, --degree <bits>     crc_search generator degree, 1 to " << MAX_SEARCH_DEGREE
+            << " (default: the width of the algorithm)" << std::endl
+            << "  -f, --filter <name>     crc_search generators: all, x+1"
+            << " (default: " << DEFAULT_GENERATOR_FILTER << ")" << std::endl
+            << "  -t, --top <count>       crc_search generators printed"
+            << " (default: " << DEFAULT_TOP_COUNT << ")" << std::endl
+            << "  -x, --correct <bits>    crc_rx repairs errors of up to this many bits: 0, 1, 2"
+            << " (default: " << DEFAULT_CORRECTION_WEIGHT << ")" << std::endl
+            << "  -i, --input <file>      crc_tx and crc_rx binary mode on the raw bytes of a file, - for stdin"
+            << " (default: the text files)" << std::endl
+            << "  -r, --record-size <bytes>  binary mode payload bytes per record, 0 for the whole input"
+            << " (default: " << DEFAULT_RECORD_SIZE << ")" << std::endl
+            << "  -F, --framed            binary mode records are length-prefixed frames, for crc_tx | channel | crc_rx"
+            << std::endl
+            << "  -o, --output <mode>     results of crc_tx, crc_rx and crc_vs_checksum: text, binary, summary"
+            << " (default: " << DEFAULT_RESULT_MODE << ")" << std::endl
+            << "  -O, --output-file <file>  file of the results, - for stdout"
+            << " (default: " << DEFAULT_RESULT_OUTPUT << ")" << std::endl
+            << "  -p, --profile           print the time of every pipeline stage and the record latencies to stderr"
+            << std::endl;
+
+    std::cerr << "usage: " << program_name << " [options]" << std::endl;
+    std::istringstream usage_lines(usage_data.str());
+    for (std::string usage_line; std::getline(usage_lines, usage_line);) {
+        if (program_options.find(usage_line[3]) != std::string::npos) {
+            std::cerr << usage_line << std::endl;
+        }
+    }
+}
@@ -0,0 +1,116 @@
+#ifndef CRC_OPTIONS_H
+#define CRC_OPTIONS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "arq_simulator.h"
+#include "checksum_engine.h"
+#include "monte_carlo.h"
+#include "result_writer.h"
+
+// default CRC algorithm, the CRC-12 generator 1100000001111
+#define DEFAULT_CRC_ALGORITHM "crc12"
+// default CRC kernel, the fastest one the CPU supports
+#define DEFAULT_CRC_KERNEL "auto"
+// default number of threads, a single thread runs without any thread pool
+#define DEFAULT_THREAD_COUNT 1
+// default number of lines per batch of the pipeline mode, 0 for no pipeline
+#define DEFAULT_BATCH_LINE_COUNT 0
+// default word width of the crc_vs_checksum checksum in bits
+#define DEFAULT_CHECKSUM_WIDTH 8
+// default highest error weight enumerated by crc_distance
+#define DEFAULT_MAX_WEIGHT 4
+// default generators searched by crc_search
+#define DEFAULT_GENERATOR_FILTER "all"
+// highest generator degree of crc_search, the exhaustive search keeps a score for every one of the
+// ... 2^(degree - 2) candidates
+#define MAX_SEARCH_DEGREE 20
+// default number of generators printed by crc_search
+#define DEFAULT_TOP_COUNT 10
+// default highest error weight corrected by crc_rx, 0 to only check
+#define DEFAULT_CORRECTION_WEIGHT 0
+// default record size of the binary mode, 0 for the whole input as one record
+#define DEFAULT_RECORD_SIZE 0
+
+// short letters of the options every program accepts, the others are rejected with the usage
+#define CRC_TX_OPTIONS "akjbirFoOp"
+#define CRC_RX_OPTIONS "akjxirFoOp"
+#define CRC_VS_CHECKSUM_OPTIONS "akjcwneqRDlsoOp"
+#define CRC_DISTANCE_OPTIONS "ajglm"
+#define CRC_SEARCH_OPTIONS "ajlmdft"
+#define CRC_BENCH_OPTIONS "akcwls"
+#define CHANNEL_OPTIONS "esirFp"
+
+// command line options of every program, each one accepts a subset of them
+struct CrcOptions {
+    // CRC algorithm name, see DispatchCrcAlgorithm() in crc_template.h
+    std::string algorithm_name = DEFAULT_CRC_ALGORITHM;
+    // CRC kernel name, see SelectCrcKernel() in crc_kernels.cpp
+    std::string kernel_name = DEFAULT_CRC_KERNEL;
+    // number of threads for the parallel mode of large records, 0 for one thread per core
+    int thread_count = DEFAULT_THREAD_COUNT;
+    // whether -j is given, the Monte Carlo mode uses one thread per core otherwise
+    bool has_thread_count = false;
+    // number of lines per batch of the crc_tx pipeline mode, 0 to encode line by line
+    int batch_line_count = DEFAULT_BATCH_LINE_COUNT;
+    // checksum algorithm of crc_vs_checksum, see FindChecksumAlgorithm() in checksum_engine.cpp
+    std::string checksum_name = DEFAULT_CHECKSUM_ALGORITHM;
+    // word width of the crc_vs_checksum one's complement checksum: 8, 16 (RFC 1071) or 32
+    int checksum_width = DEFAULT_CHECKSUM_WIDTH;
+    // number of trials of the crc_vs_checksum Monte Carlo mode, 0 to check dataVs.txt instead, or
+    // ... number of payloads delivered at every point of the ARQ mode, 0 for DEFAULT_ARQ_FRAME_COUNT
+    uint64_t trial_count = 0;
+    // channel model of the Monte Carlo mode, see ParseErrorModel() in monte_carlo.cpp, the first of
+    // ... error_model_names
+    std::string error_model_name = DEFAULT_ERROR_MODEL;
+    // every channel model given with -e, the ARQ mode sweeps all of them
+    std::vector<std::string> error_model_names = {DEFAULT_ERROR_MODEL};
+    // ARQ protocol of the crc_vs_checksum ARQ mode, see ParseArqProtocol() in arq_simulator.cpp,
+    // ... empty for no ARQ mode
+    std::string arq_protocol_name;
+    // link of the ARQ mode: bits per second and one-way propagation delay in seconds
+    double link_bit_rate = DEFAULT_ARQ_LINK_RATE;
+    double link_delay = DEFAULT_ARQ_LINK_DELAY;
+    // number of message bits of every Monte Carlo trial and of the crc_distance codewords, the
+    // ... first of message_lengths
+    int message_length = DEFAULT_MONTE_CARLO_LENGTH;
+    // every message length given with -l, crc_search ranks the generators at all of them
+    std::vector<int> message_lengths = {DEFAULT_MONTE_CARLO_LENGTH};
+    uint64_t seed = DEFAULT_MONTE_CARLO_SEED;
+    // generator polynomial of crc_distance as a bit string, empty for the generator of the algorithm
+    std::string generator_data;
+    // highest error weight enumerated by crc_distance and crc_search
+    int max_weight = DEFAULT_MAX_WEIGHT;
+    // generator degree of crc_search, 0 for the width of the algorithm, at most MAX_SEARCH_DEGREE
+    int generator_degree = 0;
+    // generators searched by crc_search: all, or x+1 for those with the (x + 1) factor
+    std::string generator_filter = DEFAULT_GENERATOR_FILTER;
+    // number of generators printed by crc_search
+    int top_count = DEFAULT_TOP_COUNT;
+    // highest error weight crc_rx repairs: 0 to only check, 1 for single-bit errors, 2 for
+    // ... double-bit errors too
+    int correction_weight = DEFAULT_CORRECTION_WEIGHT;
+    // raw binary input of crc_tx and crc_rx, "-" for stdin, empty for the text files
+    std::string input_name;
+    // number of payload bytes per binary record, 0 for the whole input as one record
+    size_t record_size = DEFAULT_RECORD_SIZE;
+    // whether the binary records of crc_tx, channel and crc_rx are length-prefixed frames on stdout
+    // ... and the input, instead of record_size bytes each
+    bool is_framed = false;
+    // output mode of the results of crc_tx, crc_rx and crc_vs_checksum, see ParseResultMode() in
+    // ... result_writer.cpp
+    std::string result_mode_name = DEFAULT_RESULT_MODE;
+    // output of the results, "-" for stdout
+    std::string result_output_name = DEFAULT_RESULT_OUTPUT;
+    // whether crc_tx, crc_rx and crc_vs_checksum print the time of every pipeline stage to stderr
+    bool is_profiling = false;
+};
+
+CrcOptions ParseCrcOptions(int argc, char *argv[], const std::string &program_options);
+
+void PrintUsage(const char *program_name, const std::string &program_options);
+
+#endif
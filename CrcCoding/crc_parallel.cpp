@@ -0,0 +1,46 @@
+#include <algorithm>
+#include <atomic>
+#include <string>
+
+#include "crc_parallel.h"
+
+// @brief:  convert a '0'/'1' character sequence into packed bits using every thread of the pool,
+//          ... each task packs the characters of CRC_PARALLEL_CHUNK_SIZE whole bytes
+// @params: const char *bit_data
+//          size_t size, number of characters
+//          PackedBits &packed_data, the pass by reference params to store the result
+//          WorkStealingPool &pool
+// @return: bool, false if there is any character other than '0' and '1'
+// @author: Donghan Xia, 2026/10/17
+bool ParseBitStringParallel(const char *bit_data, size_t size, PackedBits &packed_data, WorkStealingPool &pool) {
+    size_t chunk_char_count = CRC_PARALLEL_CHUNK_SIZE * 8;
+    size_t chunk_count = (size + chunk_char_count - 1) / chunk_char_count;
+    if (chunk_count <= 1) {
+        return ParseBitString(bit_data, size, packed_data);
+    }
+
+    packed_data.bit_count = size;
+    packed_data.words.assign((size + 63) / 64, 0);
+
+    std::atomic<bool> is_bit_string(true);
+    uint8_t *bytes = packed_data.Bytes();
+    pool.ParallelFor(chunk_count, [&](size_t chunk_index) {
+        size_t chunk_begin = chunk_index * chunk_char_count;
+        size_t chunk_size = std::min(chunk_char_count, size - chunk_begin);
+        if (!PackBitChars(bit_data + chunk_begin, chunk_size, bytes + chunk_begin / 8)) {
+            is_bit_string = false;
+        }
+    });
+
+    return is_bit_string;
+}
+
+// @brief:  convert a '0'/'1' string into packed bits using every thread of the pool
+// @params: std::string bit_data
+//          PackedBits &packed_data, the pass by reference params to store the result
+//          WorkStealingPool &pool
+// @return: bool, false if there is any character other than '0' and '1'
+// @author: Donghan Xia, 2026/10/17
+bool ParseBitStringParallel(const std::string &bit_data, PackedBits &packed_data, WorkStealingPool &pool) {
+    return ParseBitStringParallel(bit_data.data(), bit_data.size(), packed_data, pool);
+}
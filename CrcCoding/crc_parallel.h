@@ -0,0 +1,71 @@
+#ifndef CRC_PARALLEL_H
+#define CRC_PARALLEL_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "crc_template.h"
+#include "thread_pool.h"
+
+// number of bytes of one record handled by one task
+#define CRC_PARALLEL_CHUNK_SIZE ((size_t) 1 << 20)
+
+bool ParseBitStringParallel(const char *bit_data, size_t size, PackedBits &packed_data, WorkStealingPool &pool);
+
+bool ParseBitStringParallel(const std::string &bit_data, PackedBits &packed_data, WorkStealingPool &pool);
+
+// @brief:  shift whole bytes through the register using every thread of the pool
+//          the data is split into chunks whose registers are computed on their own threads, starting
+//          ... from a zero register except the first one, and then merged in order by Crc::Combine()
+// @params: uint32_t crc_register, internal register
+//          const uint8_t *data
+//          size_t size, number of bytes
+//          WorkStealingPool &pool
+//          CrcType, the CRC algorithm (e.g. Crc12) chosen at compile time
+// @return: uint32_t, updated internal register
+// @author: Donghan Xia, 2026/10/17
+template <typename CrcType>
+uint32_t UpdateCrcParallel(uint32_t crc_register, const uint8_t *data, size_t size, WorkStealingPool &pool) {
+    size_t chunk_count = (size + CRC_PARALLEL_CHUNK_SIZE - 1) / CRC_PARALLEL_CHUNK_SIZE;
+    if (chunk_count <= 1) {
+        return CrcType::Update(crc_register, data, size);
+    }
+
+    std::vector<uint32_t> chunk_registers(chunk_count);
+    pool.ParallelFor(chunk_count, [&](size_t chunk_index) {
+        size_t chunk_begin = chunk_index * CRC_PARALLEL_CHUNK_SIZE;
+        size_t chunk_size = std::min(CRC_PARALLEL_CHUNK_SIZE, size - chunk_begin);
+        uint32_t start_register = chunk_index == 0 ? crc_register : 0;
+        chunk_registers[chunk_index] = CrcType::Update(start_register, data + chunk_begin, chunk_size);
+    });
+
+    crc_register = chunk_registers[0];
+    for (size_t chunk_index = 1; chunk_index < chunk_count; chunk_index++) {
+        size_t chunk_size = std::min(CRC_PARALLEL_CHUNK_SIZE, size - chunk_index * CRC_PARALLEL_CHUNK_SIZE);
+        crc_register = CrcType::Combine(crc_register, chunk_registers[chunk_index], (uint64_t) chunk_size * 8);
+    }
+    return crc_register;
+}
+
+// @brief:  calculate the CRC value of packed data using every thread of the pool
+// @params: PackedBits packed_data
+//          WorkStealingPool &pool
+//          CrcType, the CRC algorithm (e.g. Crc12) chosen at compile time
+// @return: uint32_t, CRC value
+// @author: Donghan Xia, 2026/10/17
+template <typename CrcType>
+uint32_t ComputeCrcParallel(const PackedBits &packed_data, WorkStealingPool &pool) {
+    size_t full_byte_count = packed_data.bit_count / 8;
+    int tail_bit_count = packed_data.bit_count % 8;
+
+    uint32_t crc_register = UpdateCrcParallel<CrcType>(CrcType::Begin(), packed_data.Bytes(), full_byte_count, pool);
+    if (tail_bit_count != 0) {
+        crc_register = CrcType::UpdateBits(crc_register, packed_data.Bytes()[full_byte_count], tail_bit_count);
+    }
+
+    return CrcType::Finalize(crc_register);
+}
+
+#endif
@@ -1,144 +1,151 @@
 #include <iostream>
 #include <string>
-#include <functional>
-#include <fstream>
-
+#include <memory>
+#include <string_view>
+#include <vector>
+
+#include "crc_template.h"
+#include "crc_options.h"
+#include "crc_stages.h"
+#include "pipeline.h"
+#include "stage_profiler.h"
 #include "crc_rx.h"
 
-// @brief:  decide if received CRC data should be accepted by checking 
-//          ... whether its mod 2 division result can be divided exactly (remainder is a zero sequence)
-// @params: std::string received_data, the original data that are read from dataRx.txt file
-//          std::string generator_data, the CRC-12 generator string
+// @brief:  show the CRC check result
+//          if the remainder has bit '1', the CRC result is "not pass" because the received data
+//          ... cannot be diveded exactly
+//          if not, the CRC result is "pass"
+// @params: bool is_accepted, whether the remainder is a zero sequence
+//          ResultWriter &result_writer, the buffered output of the text
 // @return: void
 // @author: Donghan Xia, 2021/09/20
-void CheckCrc(std::string received_data, std::string generator_data) {
-    std::string original_data = received_data;
-
-    // calculate the highest digit bit of CRC generator
-    int generator_size = generator_data.size();
-
-    // calculate size of received data
-    int received_size = received_data.size();
-
-    // calculate the end-division digit at which the mod 2 division will stop
-    int end_div_digit = received_size - generator_size;
-    
-    // perform mod 2 division
-    int div_index = 0;
-    while (true) {
-        // upper-bound condition
-        if (div_index > end_div_digit) {
-            break;
-        }
+void CheckRemainder(bool is_accepted, ResultWriter &result_writer) {
+    std::string_view result_words = "pass\n";
 
-        for (int iter_index = 0; iter_index < generator_size; iter_index++) {
-            received_data[div_index + iter_index] 
-                    = XorSingleBit(received_data[div_index + iter_index], generator_data[iter_index]);
-        }
-        // make div_index point to next non-zero bit digit
-        FindNextDivDigit(div_index, received_data);
+    if (!is_accepted) {
+        result_words = "not pass\n";
     }
 
-    CheckRemainder(received_data);
-
+    result_writer.WriteText(result_words);
 }
 
-// @brief:  check if the remainder has char '1'
-//          if has, the CRC result is "not pass" because the received data cannot be diveded exactly
-//          if not, the CRC result is "pass"
-// @params: std::string, the received data
+// @brief:  show the bits a correction flipped and the repaired data, e.g. "corrected 3 17: 1010..."
+// @params: std::vector<size_t> corrected_bits, the bit indexes from the beginning of the line
+//          std::string_view repaired_data
+//          ResultWriter &result_writer, the buffered output of the text
 // @return: void
-// @author: Donghan Xia, 2021/09/20
-void CheckRemainder(std::string result_data) {
-    std::string result_words = "pass";
-
-    // use string::find() to locate the position of char '1'
-    // string::find() will return to a static value which refers to string::npos
-    // ... when there is no char '1' in the given string
-    if (result_data.find('1') != result_data.npos) {
-        result_words = "not pass";
+// @author: Donghan Xia, 2026/10/17
+void ReportCorrection(const std::vector<size_t> &corrected_bits, std::string_view repaired_data, ResultWriter &result_writer) {
+    std::string report_data = "corrected";
+    for (size_t bit_index : corrected_bits) {
+        report_data += " " + std::to_string(bit_index);
     }
-
-    std::cout << result_words << std::endl;
+    report_data += ": ";
+    result_writer.WriteText(report_data);
+    result_writer.WriteText(repaired_data);
+    result_writer.WriteText("\n");
 }
 
-// @brief:  make division index points to next division place
-//          same as the FindNextDivDigit() function defined in crc_tx.cpp
-// @params: int &div_index, the pass by reference params to provide the address of division index
-//          std::string, the received data
-// @return: int index that points to the start digit of next mod 2 division iteration
-// @author: Donghan Xia, 2021/09/19
-void FindNextDivDigit(int &div_index, std::string received_data) {
-    while (true) {
-        // upper-bound condition
-        if (div_index >= received_data.size()) {
-            break;
-        }
-        // next non-zero division place condition
-        if (received_data[div_index] == '1') {
-            break;
-        }
-
-        div_index++;
+// @brief:  show the CRC check result of each record, only counted unless the results are text
+// @params: PipelineRecord &record, the record after the checker stage
+// @return: bool, always true
+// @author: Donghan Xia, 2026/10/17
+bool PrintCheckResult::Process(PipelineRecord &record) {
+    ResultStatus status = !record.corrected_bits.empty() ? RESULT_CORRECTED : record.is_accepted ? RESULT_PASSED : RESULT_FAILED;
+    result_writer_->WriteResult(0, record.line_number, record.syndrome, record.check_width, status);
+    if (!result_writer_->IsTextMode()) {
+        return true;
     }
-}
 
-// @brief:  bitwise xor operation 
-//          same as the XorSingleBit defined in crc_tx.cpp
-// @params: char first_bit
-//          char second_bit
-// @return: char result of xor operation
-// @author: Donghan Xia, 2021/09/19
-char XorSingleBit(char first_bit, char second_bit) {
-    int result = first_bit xor second_bit;
-    // cast int result to char
-    return result + '0';
+    if (!record.corrected_bits.empty()) {
+        ReportCorrection(record.corrected_bits, record.line_data, *result_writer_);
+    } else {
+        CheckRemainder(record.is_accepted, *result_writer_);
+    }
+    return true;
 }
 
-// @brief:  read all the received datas from dataRx.txt via infile stream
-//          similar to ReadSourceData() function in crc_tx.cpp
-// @params: std::function<void(std::string, std::string)>, lambda function that perform actual
-//          ... CRC check
+// @brief:  read all the received datas and then check whether the data should be accepted
+//          the whole path is one Pipeline instantiation: the lines are views into the mapped
+//          ... dataRx.txt and each line is checked without being stored as a whole, so records of
+//          ... any length are checked with constant memory
+//          with a correction weight a rejected line is looked up by its syndrome and repaired if
+//          ... its error bits are correctable, instead of waiting for a retransmission
+// @params: WorkStealingPool *pool, thread pool of the parallel mode, nullptr for a single thread
+//          int correction_weight, 0 to only check
+//          ResultWriter &result_writer, the output of the results
+//          CrcType, the CRC algorithm chosen at compile time
 // @return: void
-// @author: Donghan Xia, 2021/09/19
-void ReadReceivedData(std::function<void (std::string, std::string)> const& InvokeFunc) {
-    // define the CRC-12 generator (Hard-Code)
-    std::string generator_data = "1100000001111";
-    
-    // read dataRx.txt file via infile stream
-    std::string file_name = "dataRx.txt";
-    std::string received_data;
-
-    std::ifstream infile_stream;
-    infile_stream.open(file_name.c_str());
-
-    // use ifstream::peek() instead of ifstream::eof() to avoid the redundant end-line problem
-    while (infile_stream.peek() != EOF) {
-        // obtain data per line in dataTx.txt
-        std::getline(infile_stream, received_data);
-
-        // utilize erase-type lambda function passed by reference value to make function ReadReceivedData
-        // ... decoupled from actual CRC code check function
-        // TODO: replace erase-type lambda function with function template to avoid considerable runtime
-        // ... due to repeatedly calling erase-type lambda function
-        InvokeFunc(received_data, generator_data);
+// @author: Donghan Xia, 2021/09/20
+template <typename CrcType>
+void ReceiveData(WorkStealingPool *pool, int correction_weight, ResultWriter &result_writer) {
+    if (correction_weight > 0) {
+        Pipeline<MmapLineSource, CrcStreamCheck<CrcType>, CrcCorrect<CrcType>, PrintCheckResult> pipeline(
+            MmapLineSource("dataRx.txt"), CrcStreamCheck<CrcType>(pool), CrcCorrect<CrcType>(correction_weight),
+            PrintCheckResult(&result_writer)
+        );
+        pipeline.Run();
+        return;
     }
 
-    infile_stream.close();
+    Pipeline<MmapLineSource, CrcStreamCheck<CrcType>, PrintCheckResult> pipeline(
+        MmapLineSource("dataRx.txt"), CrcStreamCheck<CrcType>(pool), PrintCheckResult(&result_writer)
+    );
+    pipeline.Run();
 }
 
-
-// @brief:  read all the received datas and then check whether the data should be accepted
-// @params: void
+// @brief:  binary mode: check every raw record of a file or stdin, each one the payload followed by
+//          ... its CRC in big-endian bytes as crc_tx writes them, then report the throughput to stderr
+// @params: std::string input_name, "-" for stdin
+//          size_t record_size, number of payload bytes per record, 0 for the whole input as one record
+//          bool is_framed, whether every codeword is a length-prefixed frame, record_size is ignored then
+//          WorkStealingPool *pool, thread pool of the parallel mode, nullptr for a single thread
+//          ResultWriter &result_writer, the output of the results
+//          CrcType, the CRC algorithm chosen at compile time
 // @return: void
-// @author: Donghan Xia, 2021/09/20
-void ReceiveData() {
-    ReadReceivedData(CheckCrc);
+// @author: Donghan Xia, 2026/10/17
+template <typename CrcType>
+void ReceiveBinaryData(const std::string &input_name, size_t record_size, bool is_framed, WorkStealingPool *pool,
+        ResultWriter &result_writer) {
+    // a whole input record, or a frame, already ends with its CRC
+    size_t codeword_size = record_size == 0 || is_framed ? 0 : record_size + GetCrcByteCount<CrcType>();
+    Pipeline<BinaryRecordSource, CrcCheckBytes<CrcType>, PrintCheckResult, ThroughputSink> pipeline(
+        BinaryRecordSource(input_name, codeword_size, is_framed), CrcCheckBytes<CrcType>(pool), PrintCheckResult(&result_writer),
+        ThroughputSink()
+    );
+    pipeline.Run();
 }
 
-int main() {
+int main(int argc, char *argv[]) {
 
-    ReceiveData();
+    CrcOptions options = ParseCrcOptions(argc, argv, CRC_RX_OPTIONS);
+    if (options.is_profiling) {
+        EnableStageProfiling();
+    }
+
+    std::unique_ptr<WorkStealingPool> pool;
+    if (options.thread_count != 1) {
+        pool.reset(new WorkStealingPool(options.thread_count));
+    }
+
+    ResultWriter::Mode result_mode;
+    ParseResultMode(options.result_mode_name, result_mode);
+    ResultWriter result_writer(result_mode, options.result_output_name, {"crc"});
+
+    // the CRC algorithm is dispatched once, all per-line calls are resolved at compile time
+    DispatchCrcAlgorithm(options.algorithm_name, [&pool, &options, &result_writer](auto crc_algorithm) {
+        if (!options.input_name.empty()) {
+            ReceiveBinaryData<decltype(crc_algorithm)>(options.input_name, options.record_size, options.is_framed, pool.get(),
+                    result_writer);
+        } else {
+            ReceiveData<decltype(crc_algorithm)>(pool.get(), options.correction_weight, result_writer);
+        }
+    });
+    result_writer.Finish();
+
+    if (options.is_profiling) {
+        PrintStageProfile();
+    }
 
     return 0;
-}
\ No newline at end of file
+}
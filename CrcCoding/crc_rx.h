@@ -1,13 +1,32 @@
 #include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
 
-void CheckCrc(std::string received_data, std::string generator_data);
+#include "thread_pool.h"
+#include "pipeline.h"
+#include "result_writer.h"
 
-void CheckRemainder(std::string result_data);
+// sink: print "pass" or "not pass" for each record, or the repaired line of a corrected one
+class PrintCheckResult : public PipelineStage {
+public:
+    static constexpr ProfileStage kProfileStage = PROFILE_OUTPUT;
 
-void FindNextDivDigit(int &div_index, std::string received_data);
+    explicit PrintCheckResult(ResultWriter *result_writer) : result_writer_(result_writer) {}
 
-char XorSingleBit(char first_bit, char second_bit);
+    bool Process(PipelineRecord &record);
 
-void ReceiveData();
+private:
+    ResultWriter *result_writer_;
+};
 
-void ReadReceivedData(std::function<void (std::string, std::string)> const& InvokeFunc);
\ No newline at end of file
+void CheckRemainder(bool is_accepted, ResultWriter &result_writer);
+
+void ReportCorrection(const std::vector<size_t> &corrected_bits, std::string_view repaired_data, ResultWriter &result_writer);
+
+template <typename CrcType>
+void ReceiveData(WorkStealingPool *pool, int correction_weight, ResultWriter &result_writer);
+
+template <typename CrcType>
+void ReceiveBinaryData(const std::string &input_name, size_t record_size, bool is_framed, WorkStealingPool *pool,
+        ResultWriter &result_writer);
\ No newline at end of file
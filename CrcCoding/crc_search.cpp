@@ -0,0 +1,209 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "crc_options.h"
+#include "thread_pool.h"
+#include "crc_weights.h"
+#include "crc_search.h"
+
+// @brief:  get the reciprocal generator, whose coefficients are in the reverse order
+//          a generator and its reciprocal detect the mirrored error patterns, so both have the
+//          ... same weight distribution and only one of them needs to be searched
+// @params: uint64_t poly_value
+//          int degree
+// @return: uint64_t
+// @author: Donghan Xia, 2026/10/17
+uint64_t ReflectGenerator(uint64_t poly_value, int degree) {
+    uint64_t reflected_value = 0;
+    for (int power = 0; power <= degree; power++) {
+        reflected_value = (reflected_value << 1) | ((poly_value >> power) & 1);
+    }
+    return reflected_value;
+}
+
+// @brief:  decide if a generator is one of the candidates: its x^0 coefficient is 1 (otherwise x
+//          ... divides it and it is a weaker generator of a lower degree), it is not larger than its
+//          ... reciprocal and it passes the filter
+// @params: uint64_t poly_value
+//          int degree
+//          std::string generator_filter, all, or x+1 for an even number of coefficients
+// @return: bool
+// @author: Donghan Xia, 2026/10/17
+bool IsCandidateSearched(uint64_t poly_value, int degree, const std::string &generator_filter) {
+    if ((poly_value & 1) == 0 || poly_value > ReflectGenerator(poly_value, degree)) {
+        return false;
+    }
+    // (x + 1) divides the generator exactly when it has an even number of coefficients, and then
+    // ... every odd weight error is detected
+    if (generator_filter == "x+1" && __builtin_popcountll(poly_value) % 2 != 0) {
+        return false;
+    }
+    return true;
+}
+
+// @brief:  rank two candidates: the larger Hamming distance at the longest length wins, then the
+//          ... fewer undetectable patterns of that weight, then the same at the next length
+//          a pruned candidate only has its first length, which already ranks it below every
+//          ... candidate that was scored further, see SearchGenerators()
+// @params: CandidateScore candidate
+//          CandidateScore other
+// @return: bool, whether candidate ranks before other
+// @author: Donghan Xia, 2026/10/17
+bool IsBetterCandidate(const CandidateScore &candidate, const CandidateScore &other) {
+    size_t length_count = std::min(candidate.hamming_distances.size(), other.hamming_distances.size());
+    for (size_t length_index = 0; length_index < length_count; length_index++) {
+        if (candidate.hamming_distances[length_index] != other.hamming_distances[length_index]) {
+            return candidate.hamming_distances[length_index] > other.hamming_distances[length_index];
+        }
+        if (candidate.undetectable_counts[length_index] != other.undetectable_counts[length_index]) {
+            return candidate.undetectable_counts[length_index] < other.undetectable_counts[length_index];
+        }
+    }
+    return candidate.generator.poly_value < other.generator.poly_value;
+}
+
+// @brief:  find the Hamming distance of a candidate and its undetectable patterns of that weight at
+//          ... the lengths after those already scored, up to length_count lengths, longest length
+//          ... first
+//          the syndrome of a bit only depends on its distance to the end of the codeword, so the
+//          ... syndromes of the shorter codewords are the beginning of those of the longest one
+// @params: CandidateScore &candidate, the pass by reference params with the generator to score
+//          std::vector<int> message_lengths, sorted from the longest
+//          int max_weight
+//          size_t length_count, number of lengths scored when it returns
+// @return: void
+// @author: Donghan Xia, 2026/10/17
+void ScoreCandidate(CandidateScore &candidate, const std::vector<int> &message_lengths, int max_weight, size_t length_count) {
+    int degree = candidate.generator.degree;
+    std::vector<uint32_t> longest_syndromes = BuildBitSyndromes(candidate.generator, message_lengths[0] + degree);
+
+    for (size_t length_index = candidate.hamming_distances.size(); length_index < length_count; length_index++) {
+        std::vector<uint32_t> bit_syndromes(longest_syndromes.begin(),
+                longest_syndromes.begin() + message_lengths[length_index] + degree);
+
+        // the Hamming distance at a shorter length is never lower
+        int start_weight = length_index == 0 ? 1 : candidate.hamming_distances[length_index - 1];
+        int hamming_distance = max_weight + 1;
+        uint64_t undetectable_count = 0;
+        for (int error_weight = start_weight; error_weight <= max_weight; error_weight++) {
+            undetectable_count = CountUndetectableOfWeight(bit_syndromes, error_weight);
+            if (undetectable_count > 0) {
+                hamming_distance = error_weight;
+                break;
+            }
+        }
+        candidate.hamming_distances.push_back(hamming_distance);
+        candidate.undetectable_counts.push_back(undetectable_count);
+    }
+}
+
+// @brief:  search every generator of a degree and print the best ones
+// @params: int degree
+//          std::vector<int> message_lengths
+//          int max_weight
+//          std::string generator_filter
+//          int top_count
+//          WorkStealingPool &pool, every candidate is one task
+// @return: void
+// @author: Donghan Xia, 2026/10/17
+void SearchGenerators(int degree, std::vector<int> message_lengths, int max_weight, const std::string &generator_filter,
+        int top_count, WorkStealingPool &pool) {
+    std::sort(message_lengths.begin(), message_lengths.end(), std::greater<int>());
+    message_lengths.erase(std::unique(message_lengths.begin(), message_lengths.end()), message_lengths.end());
+
+    // every generator of the degree, the highest coefficient is always 1
+    std::vector<CandidateScore> candidates;
+    for (uint64_t low_value = 0; low_value < ((uint64_t) 1 << degree); low_value++) {
+        uint64_t poly_value = ((uint64_t) 1 << degree) | low_value;
+        if (IsCandidateSearched(poly_value, degree, generator_filter)) {
+            CandidateScore candidate;
+            candidate.generator = {poly_value, degree};
+            candidates.push_back(candidate);
+        }
+    }
+
+    // every candidate is scored at the longest length first, the lowest weights are the cheapest to
+    // ... count; only the candidates that can still reach the shown ranks, i.e. those not below the
+    // ... top_count-th one at the longest length, are scored at the other lengths, so the shown
+    // ... ranks are complete and the same for any number of threads
+    auto start_time = std::chrono::steady_clock::now();
+    pool.ParallelFor(candidates.size(), [&](size_t candidate_index) {
+        ScoreCandidate(candidates[candidate_index], message_lengths, max_weight, 1);
+    });
+
+    size_t shown_count = std::min(candidates.size(), (size_t) top_count);
+    std::vector<CandidateScore *> scored_candidates;
+    if (shown_count > 0) {
+        std::nth_element(candidates.begin(), candidates.begin() + shown_count - 1, candidates.end(), IsBetterCandidate);
+        const CandidateScore &last_shown = candidates[shown_count - 1];
+        for (CandidateScore &candidate : candidates) {
+            candidate.is_pruned = candidate.hamming_distances[0] < last_shown.hamming_distances[0]
+                    || (candidate.hamming_distances[0] == last_shown.hamming_distances[0]
+                    && candidate.undetectable_counts[0] > last_shown.undetectable_counts[0]);
+            if (!candidate.is_pruned) {
+                scored_candidates.push_back(&candidate);
+            }
+        }
+    }
+    pool.ParallelFor(scored_candidates.size(), [&](size_t candidate_index) {
+        ScoreCandidate(*scored_candidates[candidate_index], message_lengths, max_weight, message_lengths.size());
+    });
+    double elapsed_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+
+    size_t pruned_count = candidates.size() - scored_candidates.size();
+    std::partial_sort(candidates.begin(), candidates.begin() + shown_count, candidates.end(), IsBetterCandidate);
+
+    std::cout << "degree: " << degree << "  filter: " << generator_filter << "  candidates: " << candidates.size()
+            << "  pruned: " << pruned_count << "  threads: " << pool.GetThreadCount() << std::endl;
+    std::cout << "rank  generator (reciprocal)";
+    for (int message_length : message_lengths) {
+        std::cout << "  HD/undetectable@" << message_length;
+    }
+    std::cout << std::endl;
+
+    for (size_t rank = 0; rank < shown_count; rank++) {
+        const CandidateScore &candidate = candidates[rank];
+        GeneratorPolynomial reciprocal = {ReflectGenerator(candidate.generator.poly_value, degree), degree};
+        std::cout << rank + 1 << "  " << FormatGeneratorPolynomial(candidate.generator)
+                << " (" << FormatGeneratorPolynomial(reciprocal) << ")";
+        for (size_t length_index = 0; length_index < candidate.hamming_distances.size(); length_index++) {
+            // the distance is only a lower bound when no pattern up to max_weight is undetectable
+            std::cout << "  " << (candidate.hamming_distances[length_index] > max_weight ? ">" : "")
+                    << std::min(candidate.hamming_distances[length_index], max_weight)
+                    << "/" << candidate.undetectable_counts[length_index];
+        }
+        std::cout << std::endl;
+    }
+    std::cout << "time: " << elapsed_seconds << " s" << std::endl;
+}
+
+int main(int argc, char *argv[]) {
+
+    CrcOptions options = ParseCrcOptions(argc, argv, CRC_SEARCH_OPTIONS);
+
+    // the width of the selected CRC algorithm unless a degree is given
+    int degree = options.generator_degree;
+    if (degree == 0) {
+        GeneratorPolynomial generator;
+        FindAlgorithmGenerator(options.algorithm_name, generator);
+        degree = generator.degree;
+    }
+    if (degree > MAX_SEARCH_DEGREE) {
+        std::cerr << "the exhaustive search covers degrees up to " << MAX_SEARCH_DEGREE << ", "
+                << options.algorithm_name << " has degree " << degree << ", give a lower one with -d" << std::endl;
+        PrintUsage(argv[0], CRC_SEARCH_OPTIONS);
+        exit(EXIT_FAILURE);
+    }
+
+    // the search uses every core unless -j is given
+    WorkStealingPool pool(options.has_thread_count ? options.thread_count : 0);
+    SearchGenerators(degree, options.message_lengths, options.max_weight, options.generator_filter,
+            options.top_count, pool);
+
+    return 0;
+}
@@ -0,0 +1,29 @@
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "thread_pool.h"
+#include "crc_weights.h"
+
+// score of one candidate generator at every message length, longest length first
+struct CandidateScore {
+    GeneratorPolynomial generator;
+    // Hamming distance at each length, max_weight + 1 if every pattern up to max_weight is detected
+    std::vector<int> hamming_distances;
+    // number of undetectable patterns of the Hamming distance weight at each length
+    std::vector<uint64_t> undetectable_counts;
+    // whether the candidate was dropped after its first length because it ranks below the shown ones
+    bool is_pruned = false;
+};
+
+uint64_t ReflectGenerator(uint64_t poly_value, int degree);
+
+bool IsCandidateSearched(uint64_t poly_value, int degree, const std::string &generator_filter);
+
+bool IsBetterCandidate(const CandidateScore &candidate, const CandidateScore &other);
+
+void ScoreCandidate(CandidateScore &candidate, const std::vector<int> &message_lengths, int max_weight, size_t length_count);
+
+void SearchGenerators(int degree, std::vector<int> message_lengths, int max_weight, const std::string &generator_filter,
+        int top_count, WorkStealingPool &pool);
\ No newline at end of file
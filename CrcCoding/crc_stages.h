@@ -0,0 +1,296 @@
+#ifndef CRC_STAGES_H
+#define CRC_STAGES_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include "crc_template.h"
+#include "crc_parallel.h"
+#include "crc_syndrome.h"
+#include "pipeline.h"
+
+// number of characters shifted through the CRC register at a time by CrcStreamCheck
+#define CRC_STREAM_CHUNK_SIZE 65536
+// number of characters shifted at a time per thread in the parallel mode, 2 tasks of
+// ... CRC_PARALLEL_CHUNK_SIZE bytes each
+#define CRC_STREAM_PARALLEL_CHUNK_SIZE (CRC_PARALLEL_CHUNK_SIZE * 16)
+
+// stage: calculate the CRC of the source data and append it to get the encoded data
+template <typename CrcType>
+class CrcEncode : public PipelineStage {
+public:
+    static constexpr ProfileStage kProfileStage = PROFILE_ENCODE;
+
+    // @brief:  in the parallel mode every chunk of a large record is divided on its own thread and
+    //          ... the remainders are combined afterwards
+    // @params: WorkStealingPool *pool, thread pool of the parallel mode, nullptr for a single thread
+    // @author: Donghan Xia, 2026/10/17
+    explicit CrcEncode(WorkStealingPool *pool = nullptr) : pool_(pool) {}
+
+    bool Process(PipelineRecord &record) {
+        // the compile-time lookup tables perform the mod 2 division on packed bits, which yields
+        // ... the same remainder as appending zeros and dividing bit by bit
+        record.check_value = pool_ != nullptr
+                ? ComputeCrcParallel<CrcType>(record.source_data, *pool_)
+                : CrcType::Compute(record.source_data);
+        record.check_width = CrcType::kWidth;
+
+        // encoded_data can be obtained by appending CRC code to the original data
+        record.encoded_data = record.source_data;
+        AppendBits(record.encoded_data, record.check_value, CrcType::kWidth);
+        return true;
+    }
+
+private:
+    WorkStealingPool *pool_;
+};
+
+// stage: decide if the encoded data would be accepted after the error bits are introduced, from the
+// ... syndromes of the error bits alone, i.e. one table lookup per error bit instead of dividing the
+// ... whole corrupted codeword again; the encoded data itself is left as it is
+template <typename CrcType>
+class CrcSyndromeCheck : public PipelineStage {
+public:
+    static constexpr ProfileStage kProfileStage = PROFILE_CHECK;
+
+    bool Process(PipelineRecord &record) {
+        syndrome_table_.Extend(record.encoded_data.bit_count);
+        record.is_accepted = syndrome_table_.GetSyndrome(record.error_bit_data, record.encoded_data.bit_count) == 0;
+        return true;
+    }
+
+private:
+    // grows to the longest codeword seen so far
+    CrcSyndromeTable<CrcType> syndrome_table_;
+};
+
+// stage: check a received line as a codeword without storing it as a whole
+// the whole bytes of the data section are packed and shifted through a CrcState one chunk at a
+// ... time, then the rest of the data section, and the CRC is compared with the CRC section, so
+// ... records of any length are checked with constant memory
+// lines with any character other than '0' and '1' are dropped
+template <typename CrcType>
+class CrcStreamCheck : public PipelineStage {
+public:
+    // the characters are packed one chunk at a time while they are divided, so parsing counts as checking
+    static constexpr ProfileStage kProfileStage = PROFILE_CHECK;
+
+    // @params: WorkStealingPool *pool, thread pool of the parallel mode, nullptr for a single thread
+    //          std::string *error_data, nullptr to report the dropped lines to stderr
+    // @author: Donghan Xia, 2026/10/17
+    explicit CrcStreamCheck(WorkStealingPool *pool = nullptr, std::string *error_data = nullptr)
+            : pool_(pool), error_data_(error_data) {}
+
+    bool Process(PipelineRecord &record) {
+        record.check_width = CrcType::kWidth;
+        if (!CheckLine(record)) {
+            ReportSkippedRecord(record, error_data_);
+            return false;
+        }
+        return true;
+    }
+
+private:
+    // @brief:  decide if the line should be accepted
+    // @params: PipelineRecord &record, the pass by reference params of the line and the result
+    // @return: bool, false if there is any character other than '0' and '1'
+    // @author: Donghan Xia, 2026/10/17
+    bool CheckLine(PipelineRecord &record) {
+        std::string_view received_data = record.line_data;
+        size_t message_char_count = received_data.size() - std::min(received_data.size(), (size_t) CrcType::kWidth);
+        size_t shift_char_count = message_char_count / 8 * 8;
+
+        CrcState<CrcType> crc_state;
+        if (!ShiftChunks(crc_state, received_data.substr(0, shift_char_count), record.file_reader)) {
+            return false;
+        }
+
+        // the rest of the data section and the CRC section
+        std::string_view tail_chars = received_data.substr(shift_char_count);
+        if (!ParseBitString(tail_chars.data(), tail_chars.size(), packed_chunk_)) {
+            return false;
+        }
+
+        // a record shorter than the CRC section can be divided exactly only if it is all zeros
+        if (received_data.size() < (size_t) CrcType::kWidth) {
+            record.syndrome = ExtractBits(packed_chunk_, 0, packed_chunk_.bit_count);
+            record.is_accepted = record.syndrome == 0;
+            return true;
+        }
+
+        // comparing the CRC of the data section with the CRC section is equivalent to checking
+        // ... that the whole received data can be divided exactly by the generator
+        size_t tail_message_bit_count = packed_chunk_.bit_count - CrcType::kWidth;
+        crc_state.Update(packed_chunk_, tail_message_bit_count);
+
+        record.syndrome = crc_state.Finalize() ^ ExtractBits(packed_chunk_, tail_message_bit_count, CrcType::kWidth);
+        record.is_accepted = record.syndrome == 0;
+        return true;
+    }
+
+    // @brief:  shift characters of whole bytes through the CRC register one chunk at a time, the
+    //          ... pages of the mapped file that are done with are handed back to the kernel
+    // @params: CrcState<CrcType> &crc_state, the pass by reference params of the CRC register
+    //          std::string_view bit_chars, a multiple of 8 characters
+    //          MmapReader *file_reader, the reader that maps the characters, nullptr if not mapped
+    // @return: bool, false if there is any character other than '0' and '1'
+    // @author: Donghan Xia, 2026/10/17
+    bool ShiftChunks(CrcState<CrcType> &crc_state, std::string_view bit_chars, MmapReader *file_reader) {
+        size_t chunk_size = pool_ != nullptr
+                ? CRC_STREAM_PARALLEL_CHUNK_SIZE * pool_->GetThreadCount()
+                : CRC_STREAM_CHUNK_SIZE;
+
+        while (!bit_chars.empty()) {
+            std::string_view chunk_chars = bit_chars.substr(0, chunk_size);
+
+            if (pool_ != nullptr) {
+                // pack and divide the pieces of the chunk on their own threads and combine the remainders
+                if (!ParseBitStringParallel(chunk_chars.data(), chunk_chars.size(), packed_chunk_, *pool_)) {
+                    return false;
+                }
+                uint32_t crc_register = crc_state.GetRegister();
+                crc_register = UpdateCrcParallel<CrcType>(crc_register, packed_chunk_.Bytes(), chunk_chars.size() / 8, *pool_);
+                crc_state = CrcState<CrcType>(crc_register);
+            } else {
+                if (!ParseBitString(chunk_chars.data(), chunk_chars.size(), packed_chunk_)) {
+                    return false;
+                }
+                crc_state.Update(packed_chunk_.Bytes(), chunk_chars.size() / 8);
+            }
+
+            bit_chars.remove_prefix(chunk_chars.size());
+            if (file_reader != nullptr) {
+                file_reader->ReleaseBefore(bit_chars.data());
+            }
+        }
+        return true;
+    }
+
+    WorkStealingPool *pool_;
+    std::string *error_data_;
+    // packed bits of the last chunk, reused for every chunk
+    PackedBits packed_chunk_;
+};
+
+// @brief:  get the number of bytes of the CRC appended to a binary record
+// @params: CrcType, the CRC algorithm chosen at compile time
+// @return: size_t
+// @author: Donghan Xia, 2026/10/17
+template <typename CrcType>
+constexpr size_t GetCrcByteCount() {
+    return (CrcType::kWidth + 7) / 8;
+}
+
+// stage: calculate the CRC of the raw bytes of a binary record
+// large records are divided on every thread of the pool in the parallel mode, like CrcEncode
+template <typename CrcType>
+class CrcEncodeBytes : public PipelineStage {
+public:
+    static constexpr ProfileStage kProfileStage = PROFILE_ENCODE;
+
+    // @params: WorkStealingPool *pool, thread pool of the parallel mode, nullptr for a single thread
+    // @author: Donghan Xia, 2026/10/17
+    explicit CrcEncodeBytes(WorkStealingPool *pool = nullptr) : pool_(pool) {}
+
+    bool Process(PipelineRecord &record) {
+        const uint8_t *record_bytes = (const uint8_t *) record.line_data.data();
+        uint32_t crc_register = pool_ != nullptr
+                ? UpdateCrcParallel<CrcType>(CrcType::Begin(), record_bytes, record.line_data.size(), *pool_)
+                : CrcType::Update(CrcType::Begin(), record_bytes, record.line_data.size());
+        record.check_value = CrcType::Finalize(crc_register);
+        record.check_width = CrcType::kWidth;
+        return true;
+    }
+
+private:
+    WorkStealingPool *pool_;
+};
+
+// stage: check a binary record that ends with its CRC in GetCrcByteCount() big-endian bytes, as
+// ... written by crc_tx, a record too short to hold a CRC is rejected
+template <typename CrcType>
+class CrcCheckBytes : public PipelineStage {
+public:
+    static constexpr ProfileStage kProfileStage = PROFILE_CHECK;
+
+    // @params: WorkStealingPool *pool, thread pool of the parallel mode, nullptr for a single thread
+    // @author: Donghan Xia, 2026/10/17
+    explicit CrcCheckBytes(WorkStealingPool *pool = nullptr) : pool_(pool) {}
+
+    bool Process(PipelineRecord &record) {
+        record.check_width = CrcType::kWidth;
+        if (record.line_data.size() < GetCrcByteCount<CrcType>()) {
+            // a record too short to hold the CRC has no syndrome, all ones marks it rejected
+            record.syndrome = CrcType::kMask;
+            record.is_accepted = false;
+            return true;
+        }
+
+        const uint8_t *record_bytes = (const uint8_t *) record.line_data.data();
+        size_t payload_size = record.line_data.size() - GetCrcByteCount<CrcType>();
+        uint32_t crc_register = pool_ != nullptr
+                ? UpdateCrcParallel<CrcType>(CrcType::Begin(), record_bytes, payload_size, *pool_)
+                : CrcType::Update(CrcType::Begin(), record_bytes, payload_size);
+
+        uint32_t received_value = 0;
+        for (size_t byte_index = payload_size; byte_index < record.line_data.size(); byte_index++) {
+            received_value = (received_value << 8) | record_bytes[byte_index];
+        }
+        record.syndrome = CrcType::Finalize(crc_register) ^ received_value;
+        record.is_accepted = record.syndrome == 0;
+        return true;
+    }
+
+private:
+    WorkStealingPool *pool_;
+};
+
+// stage: repair a rejected line whose syndrome is that of a single-bit error, or of a double-bit
+// ... error with max_error_weight 2, within the guaranteed range of the generator
+// the repaired line replaces line_data and the flipped bits are listed in corrected_bits, so the
+// ... later stages see an accepted codeword; other lines are left as they are
+template <typename CrcType>
+class CrcCorrect : public PipelineStage {
+public:
+    static constexpr ProfileStage kProfileStage = PROFILE_CHECK;
+
+    // @params: int max_error_weight, 1 or 2
+    // @author: Donghan Xia, 2026/10/17
+    explicit CrcCorrect(int max_error_weight) : correction_table_(max_error_weight) {}
+
+    bool Process(PipelineRecord &record) {
+        record.corrected_bits.clear();
+        if (record.is_accepted) {
+            return true;
+        }
+
+        size_t codeword_bit_count = record.line_data.size();
+        correction_table_.Extend(codeword_bit_count);
+        CorrectablePattern pattern;
+        if (!correction_table_.FindPattern(record.syndrome, codeword_bit_count, pattern)) {
+            return true;
+        }
+
+        // the mapped input is read-only, the repaired line is a copy
+        repaired_data_.assign(record.line_data);
+        for (int bit_index = pattern.bit_count - 1; bit_index >= 0; bit_index--) {
+            size_t char_index = CrcSyndromeTable<CrcType>::GetBitIndex(pattern.end_distances[bit_index], codeword_bit_count);
+            repaired_data_[char_index] = repaired_data_[char_index] == '0' ? '1' : '0';
+            record.corrected_bits.push_back(char_index);
+        }
+        record.line_data = repaired_data_;
+        record.syndrome = 0;
+        record.is_accepted = true;
+        return true;
+    }
+
+private:
+    CrcCorrectionTable<CrcType> correction_table_;
+    // the last repaired line, line_data points into it
+    std::string repaired_data_;
+};
+
+#endif
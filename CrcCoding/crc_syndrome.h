@@ -0,0 +1,244 @@
+#ifndef CRC_SYNDROME_H
+#define CRC_SYNDROME_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "bit_packing.h"
+#include "crc_template.h"
+
+// syndromes of single-bit errors, used to check error bits without dividing the codeword again
+// CRC is linear in GF(2): the CRC of a corrupted message is the CRC of the message xored with the
+// ... CRC of the error bits alone (with a zero initial register and no XorOut), so a valid codeword
+// ... with errors is accepted exactly when the syndrome of its error bits is zero, and the
+// ... syndrome is the xor of the syndromes of the single error bits
+// the syndrome of an error bit only depends on its distance to the end of the codeword: the last
+// ... Width bits are the CRC section itself, every bit before that is a one shifted over the zero
+// ... bits after it, so one table serves codewords of every length
+// a reflected CRC shifts the whole bytes of the message in least significant bit first, so there
+// ... the distance is counted in that order, see GetEndDistance()
+template <typename CrcType>
+class CrcSyndromeTable {
+public:
+    // @brief:  build the syndromes of codewords up to codeword_bit_count bits
+    // @params: size_t codeword_bit_count
+    // @author: Donghan Xia, 2026/10/17
+    explicit CrcSyndromeTable(size_t codeword_bit_count = 0) {
+        Extend(codeword_bit_count);
+    }
+
+    // @brief:  add the syndromes of longer codewords, each one is the previous one shifted over one
+    //          ... more zero bit
+    // @params: size_t codeword_bit_count
+    // @return: void
+    // @author: Donghan Xia, 2026/10/17
+    void Extend(size_t codeword_bit_count) {
+        while (syndromes_.size() < codeword_bit_count) {
+            size_t end_distance = syndromes_.size();
+            if (end_distance < (size_t) CrcType::kWidth) {
+                syndromes_.push_back((uint32_t) 1 << end_distance);
+                continue;
+            }
+
+            if (end_distance == (size_t) CrcType::kWidth) {
+                error_register_ = CrcType::UpdateBits(0, 0x80, 1);
+            } else {
+                error_register_ = CrcType::UpdateBits(error_register_, 0, 1);
+            }
+            // Finalize() is affine, xoring the value of a zero register leaves its linear part
+            syndromes_.push_back(CrcType::Finalize(error_register_) ^ CrcType::Finalize(0));
+        }
+    }
+
+    size_t GetCodewordBitCount() const {
+        return syndromes_.size();
+    }
+
+    // syndrome of an error bit end_distance bits before the end of the codeword
+    uint32_t GetBitSyndrome(size_t end_distance) const {
+        return syndromes_[end_distance];
+    }
+
+    // @brief:  get the distance of a bit to the end of the codeword in the order the bits are
+    //          ... shifted through the register, which is the bit order except inside the whole
+    //          ... bytes of the message of a reflected CRC, the bits after them go in one by one
+    // @params: size_t bit_index, from the beginning of the codeword
+    //          size_t codeword_bit_count
+    // @return: size_t, the table index of the bit
+    // @author: Donghan Xia, 2026/10/17
+    static size_t GetEndDistance(size_t bit_index, size_t codeword_bit_count) {
+        size_t message_bit_count = codeword_bit_count - std::min(codeword_bit_count, (size_t) CrcType::kWidth);
+        if (CrcType::kRefIn && bit_index < message_bit_count / 8 * 8) {
+            bit_index ^= 7;
+        }
+        return codeword_bit_count - 1 - bit_index;
+    }
+
+    // @brief:  get the bit of a table index, the inverse of GetEndDistance()
+    // @params: size_t end_distance
+    //          size_t codeword_bit_count
+    // @return: size_t, bit index from the beginning of the codeword
+    // @author: Donghan Xia, 2026/10/17
+    static size_t GetBitIndex(size_t end_distance, size_t codeword_bit_count) {
+        return codeword_bit_count - 1 - GetEndDistance(codeword_bit_count - 1 - end_distance, codeword_bit_count);
+    }
+
+    // @brief:  get the syndrome of the error bits introduced into a codeword in O(number of error
+    //          ... bits), error bits beyond the end of the codeword are ignored like XorBits() does
+    // @params: PackedBits error_bit_data
+    //          size_t codeword_bit_count, at most GetCodewordBitCount()
+    // @return: uint32_t, zero if the errors are undetected
+    // @author: Donghan Xia, 2026/10/17
+    uint32_t GetSyndrome(const PackedBits &error_bit_data, size_t codeword_bit_count) const {
+        size_t word_count = std::min(error_bit_data.words.size(), (codeword_bit_count + 63) / 64);
+        uint32_t syndrome = 0;
+
+        for (size_t word_index = 0; word_index < word_count; word_index++) {
+            // the first bit of the word in data order becomes its most significant bit
+            uint64_t error_word = __builtin_bswap64(error_bit_data.words[word_index]);
+            if ((word_index + 1) * 64 > codeword_bit_count) {
+                error_word &= ~(uint64_t) 0 << ((word_index + 1) * 64 - codeword_bit_count);
+            }
+
+            // one table lookup per error bit, lowest set bit first
+            while (error_word != 0) {
+                size_t bit_index = word_index * 64 + 63 - __builtin_ctzll(error_word);
+                syndrome ^= syndromes_[GetEndDistance(bit_index, codeword_bit_count)];
+                error_word &= error_word - 1;
+            }
+        }
+
+        return syndrome;
+    }
+
+private:
+    // syndromes_[d] is the syndrome of an error bit d bits before the end of the codeword
+    std::vector<uint32_t> syndromes_;
+    // internal register of the last syndrome of the message section
+    uint32_t error_register_ = 0;
+};
+
+// error bits of a correctable syndrome, as distances to the end of the codeword in the order of
+// ... CrcSyndromeTable::GetEndDistance()
+struct CorrectablePattern {
+    size_t end_distances[2];
+    // 1 or 2
+    int bit_count;
+};
+
+// syndromes of the single-bit errors, and of the double-bit errors, mapped back to their positions
+// a pattern can only be corrected while its syndrome is shared by no other pattern of at most the
+// ... same weight, i.e. single-bit errors up to the codeword length where the Hamming distance drops
+// ... below 3 and double-bit errors up to where it drops below 5, so each map only grows while its
+// ... syndromes stay distinct and nonzero and stops at its guaranteed range, the single-bit map
+// ... keeps growing after the double-bit one has stopped
+template <typename CrcType>
+class CrcCorrectionTable {
+public:
+    // @brief:  the table is empty until it is extended
+    // @params: int max_error_weight, 1 to correct single-bit errors, 2 for double-bit errors too
+    // @author: Donghan Xia, 2026/10/17
+    explicit CrcCorrectionTable(int max_error_weight) : max_error_weight_(max_error_weight) {}
+
+    // @brief:  add the patterns of longer codewords until codeword_bit_count bits or the end of the
+    //          ... guaranteed ranges, a codeword of n bits adds n - 1 double-bit patterns
+    // @params: size_t codeword_bit_count
+    // @return: void
+    // @author: Donghan Xia, 2026/10/17
+    void Extend(size_t codeword_bit_count) {
+        while (single_bit_range_ < codeword_bit_count && single_bit_range_ == syndrome_table_.GetCodewordBitCount()) {
+            size_t end_distance = single_bit_range_;
+            syndrome_table_.Extend(end_distance + 1);
+            uint32_t bit_syndrome = syndrome_table_.GetBitSyndrome(end_distance);
+
+            // once a weight 3 or 4 pattern is undetectable the double-bit map stops at its range,
+            // ... the patterns it has stay correctable in codewords up to double_bit_range_ bits
+            if (double_bit_range_ == end_distance) {
+                ExtendDoubleBits(end_distance);
+            }
+
+            if (bit_syndrome == 0 || single_patterns_.count(bit_syndrome) != 0) {
+                return;
+            }
+            single_patterns_[bit_syndrome] = {{end_distance, 0}, 1};
+            single_bit_range_++;
+        }
+    }
+
+    // @brief:  find the error bits of a codeword with a nonzero syndrome
+    // @params: uint32_t syndrome, the CRC of the data section xored with the CRC section
+    //          size_t codeword_bit_count, call Extend() with it first
+    //          CorrectablePattern &pattern, the pass by reference params to store the result
+    // @return: bool, false if the codeword is beyond the guaranteed range of its pattern or the
+    //          ... syndrome is not of a correctable pattern
+    // @author: Donghan Xia, 2026/10/17
+    bool FindPattern(uint32_t syndrome, size_t codeword_bit_count, CorrectablePattern &pattern) const {
+        // within the double-bit range no single-bit and double-bit pattern share a syndrome, beyond
+        // ... it only the single-bit patterns are looked up
+        return FindPatternOf(single_patterns_, single_bit_range_, syndrome, codeword_bit_count, pattern)
+                || FindPatternOf(double_patterns_, double_bit_range_, syndrome, codeword_bit_count, pattern);
+    }
+
+private:
+    // @brief:  find a pattern of one weight that fits in the codeword
+    // @params: std::unordered_map<uint32_t, CorrectablePattern> patterns, the patterns of the weight
+    //          size_t guaranteed_range, codeword length up to which they are distinct
+    //          uint32_t syndrome
+    //          size_t codeword_bit_count
+    //          CorrectablePattern &pattern, the pass by reference params to store the result
+    // @return: bool
+    // @author: Donghan Xia, 2026/10/17
+    static bool FindPatternOf(const std::unordered_map<uint32_t, CorrectablePattern> &patterns, size_t guaranteed_range,
+            uint32_t syndrome, size_t codeword_bit_count, CorrectablePattern &pattern) {
+        auto pattern_iter = patterns.find(syndrome);
+        if (pattern_iter == patterns.end() || codeword_bit_count > guaranteed_range
+                || pattern_iter->second.end_distances[0] >= codeword_bit_count) {
+            return false;
+        }
+        pattern = pattern_iter->second;
+        return true;
+    }
+
+    // @brief:  add the double-bit patterns whose farther bit is end_distance bits before the end,
+    //          ... the new pattern syndromes differ from each other since the single-bit ones do
+    // @params: size_t end_distance
+    // @return: bool, false if any of the syndromes is zero or already a pattern, nothing is added then
+    // @author: Donghan Xia, 2026/10/17
+    bool ExtendDoubleBits(size_t end_distance) {
+        if (max_error_weight_ < 2) {
+            return false;
+        }
+
+        // the single-bit map holds the bits before end_distance, it grows in step until here
+        uint32_t bit_syndrome = syndrome_table_.GetBitSyndrome(end_distance);
+        if (bit_syndrome == 0 || single_patterns_.count(bit_syndrome) != 0 || double_patterns_.count(bit_syndrome) != 0) {
+            return false;
+        }
+        for (size_t other_distance = 0; other_distance < end_distance; other_distance++) {
+            uint32_t pair_syndrome = bit_syndrome ^ syndrome_table_.GetBitSyndrome(other_distance);
+            if (pair_syndrome == 0 || single_patterns_.count(pair_syndrome) != 0 || double_patterns_.count(pair_syndrome) != 0) {
+                return false;
+            }
+        }
+
+        for (size_t other_distance = 0; other_distance < end_distance; other_distance++) {
+            double_patterns_[bit_syndrome ^ syndrome_table_.GetBitSyndrome(other_distance)] = {{end_distance, other_distance}, 2};
+        }
+        double_bit_range_++;
+        return true;
+    }
+
+    int max_error_weight_;
+    CrcSyndromeTable<CrcType> syndrome_table_;
+    // correctable single-bit and double-bit patterns by syndrome
+    std::unordered_map<uint32_t, CorrectablePattern> single_patterns_;
+    std::unordered_map<uint32_t, CorrectablePattern> double_patterns_;
+    // codeword lengths up to which the single-bit and double-bit patterns are distinct
+    size_t single_bit_range_ = 0;
+    size_t double_bit_range_ = 0;
+};
+
+#endif
@@ -0,0 +1,493 @@
+#ifndef CRC_TEMPLATE_H
+#define CRC_TEMPLATE_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "bit_packing.h"
+#include "crc_kernels.h"
+
+// @brief:  reverse the order of the lowest bit_count bits of value
+// @params: uint32_t value
+//          int bit_count
+// @return: uint32_t, reflected value
+// @author: Donghan Xia, 2026/10/17
+constexpr uint32_t ReflectBits(uint32_t value, int bit_count) {
+    uint32_t result = 0;
+    for (int bit_index = 0; bit_index < bit_count; bit_index++) {
+        result = (result << 1) | ((value >> bit_index) & 1);
+    }
+    return result;
+}
+
+// lookup tables of the slicing-by-8 CRC update
+// slice[0][b] is the register after shifting byte b through an all-zero register,
+// ... slice[k][b] is the same register after k more zero bytes
+struct CrcTables {
+    uint32_t slice[CRC_SLICE_COUNT][CRC_TABLE_SIZE];
+};
+
+// @brief:  shift one data bit through the internal register
+// @params: uint32_t crc_register, internal register
+//          uint32_t data_bit
+//          uint32_t register_poly, generator in the internal register form
+// @return: uint32_t, updated internal register
+// @author: Donghan Xia, 2026/10/17
+template <bool RefIn>
+constexpr uint32_t ShiftCrcBit(uint32_t crc_register, uint32_t data_bit, uint32_t register_poly) {
+    if (RefIn) {
+        bool low_bit = (crc_register ^ data_bit) & 1;
+        crc_register >>= 1;
+        return low_bit ? crc_register ^ register_poly : crc_register;
+    }
+    bool top_bit = (crc_register >> 31) ^ data_bit;
+    crc_register <<= 1;
+    return top_bit ? crc_register ^ register_poly : crc_register;
+}
+
+// @brief:  build the slicing-by-8 lookup tables at compile time
+// @params: uint32_t register_poly, generator in the internal register form
+// @return: CrcTables
+// @author: Donghan Xia, 2026/10/17
+template <bool RefIn>
+constexpr CrcTables BuildCrcTables(uint32_t register_poly) {
+    CrcTables tables = {};
+    for (int byte_value = 0; byte_value < CRC_TABLE_SIZE; byte_value++) {
+        uint32_t crc_register = RefIn ? byte_value : (uint32_t) byte_value << 24;
+        for (int bit_index = 0; bit_index < 8; bit_index++) {
+            crc_register = ShiftCrcBit<RefIn>(crc_register, 0, register_poly);
+        }
+        tables.slice[0][byte_value] = crc_register;
+    }
+
+    for (int slice_index = 1; slice_index < CRC_SLICE_COUNT; slice_index++) {
+        for (int byte_value = 0; byte_value < CRC_TABLE_SIZE; byte_value++) {
+            uint32_t previous = tables.slice[slice_index - 1][byte_value];
+            tables.slice[slice_index][byte_value] = RefIn
+                    ? (previous >> 8) ^ tables.slice[0][previous & 0xff]
+                    : (previous << 8) ^ tables.slice[0][previous >> 24];
+        }
+    }
+    return tables;
+}
+
+// number of entries in the zero-shift table, one per bit of a 64-bit bit count
+#define CRC_SHIFT_TABLE_SIZE 64
+
+// registers of x^(2^k) mod P', used to shift a register over a long run of zero bits
+struct CrcShiftTable {
+    uint32_t power[CRC_SHIFT_TABLE_SIZE];
+};
+
+// @brief:  multiply two polynomials modulo the generator in GF(2), both given in the internal
+//          ... register form, where the coefficient of x^31 is the highest bit for non-reflected
+//          ... registers and the lowest bit for reflected registers
+//          multiplying a register by x is the same as shifting one zero bit through it, so the
+//          ... multiplicand is shifted once per coefficient of the multiplier
+// @params: uint32_t multiplier
+//          uint32_t multiplicand
+//          uint32_t register_poly, generator in the internal register form
+// @return: uint32_t, product in the internal register form
+// @author: Donghan Xia, 2026/10/17
+template <bool RefIn>
+constexpr uint32_t MultiplyCrcRegister(uint32_t multiplier, uint32_t multiplicand, uint32_t register_poly) {
+    uint32_t product = 0;
+    for (int degree = 0; degree < 32; degree++) {
+        uint32_t coefficient = RefIn ? (multiplier >> (31 - degree)) & 1 : (multiplier >> degree) & 1;
+        if (coefficient) {
+            product ^= multiplicand;
+        }
+        multiplicand = ShiftCrcBit<RefIn>(multiplicand, 0, register_poly);
+    }
+    return product;
+}
+
+// @brief:  build the registers of x^1, x^2, x^4, ... x^(2^63) mod P' at compile time by repeated squaring
+// @params: uint32_t register_poly, generator in the internal register form
+// @return: CrcShiftTable
+// @author: Donghan Xia, 2026/10/17
+template <bool RefIn>
+constexpr CrcShiftTable BuildCrcShiftTable(uint32_t register_poly) {
+    CrcShiftTable table = {};
+    // x^1 in the internal register form
+    table.power[0] = RefIn ? (uint32_t) 1 << 30 : 2;
+    for (int power_index = 1; power_index < CRC_SHIFT_TABLE_SIZE; power_index++) {
+        uint32_t previous = table.power[power_index - 1];
+        table.power[power_index] = MultiplyCrcRegister<RefIn>(previous, previous, register_poly);
+    }
+    return table;
+}
+
+// CRC algorithm described by the Rocksoft parameter model, all lookup tables are built at compile time
+// Width:  number of CRC result bits (8 to 32)
+// Poly:   generator without the highest digit, e.g. 0x80f for the CRC-12 generator 1100000001111
+// RefIn:  whether each input byte is processed starting from its least significant bit
+// RefOut: whether the final register is reflected before XorOut
+// Init:   initial register value
+// XorOut: value xored to the final register
+//
+// the register is kept in an internal form: left-aligned in 32 bits for non-reflected algorithms,
+// ... reflected and right-aligned for reflected algorithms, so that both use the same shift
+// ... direction for every width. Begin()/Finalize() convert from/to the standard CRC value
+template <int Width, uint32_t Poly, bool RefIn, bool RefOut, uint32_t Init, uint32_t XorOut>
+class Crc {
+    static_assert(Width >= 8 && Width <= 32, "CRC width must be between 8 and 32 bits");
+
+public:
+    static constexpr int kWidth = Width;
+    static constexpr uint32_t kPoly = Poly;
+    static constexpr bool kRefIn = RefIn;
+    static constexpr uint32_t kMask = Width == 32 ? 0xffffffffu : (1u << Width) - 1;
+
+    // generator in the internal register form
+    static constexpr uint32_t kRegisterPoly = RefIn ? ReflectBits(Poly, Width) : Poly << (32 - Width);
+    // whether the register can be updated by the SSE4.2 crc32 instruction
+    static constexpr bool kIsCrc32c = RefIn && Width == 32 && Poly == 0x1edc6f41;
+    // constants of the carry-less multiplication folding kernel
+    static constexpr CrcFoldConstants kFoldConstants = BuildCrcFoldConstants(RefIn, kRegisterPoly);
+
+    // @brief:  get the register value before any data is shifted in
+    // @params: void
+    // @return: uint32_t, internal register
+    // @author: Donghan Xia, 2026/10/17
+    static constexpr uint32_t Begin() {
+        return RefIn ? ReflectBits(Init, Width) : Init << (32 - Width);
+    }
+
+    // @brief:  convert the internal register to the standard CRC value
+    // @params: uint32_t crc_register
+    // @return: uint32_t, right-aligned CRC value
+    // @author: Donghan Xia, 2026/10/17
+    static constexpr uint32_t Finalize(uint32_t crc_register) {
+        uint32_t crc_value = RefIn ? crc_register : crc_register >> (32 - Width);
+        if (RefIn != RefOut) {
+            crc_value = ReflectBits(crc_value, Width);
+        }
+        return (crc_value ^ XorOut) & kMask;
+    }
+
+    // @brief:  shift whole bytes through the register
+    //          CRC-32C and large buffers go to the hardware kernels selected by CPUID (see crc_kernels.cpp),
+    //          ... everything else and the tail after the last 16-byte block uses the lookup tables
+    // @params: uint32_t crc_register, internal register
+    //          const uint8_t *data
+    //          size_t size, number of bytes
+    // @return: uint32_t, updated internal register
+    // @author: Donghan Xia, 2026/10/17
+    static uint32_t Update(uint32_t crc_register, const uint8_t *data, size_t size) {
+        // CRC-32C has its own instruction, which beats the lookup tables at any size
+        if (kIsCrc32c && crc_kernel_dispatch.crc32c != nullptr) {
+            return crc_kernel_dispatch.crc32c(crc_register, data, size);
+        }
+        if (size >= CRC_FOLD_MIN_SIZE) {
+            if (crc_kernel_dispatch.fold != nullptr) {
+                size_t block_count = size / CRC_FOLD_BLOCK_SIZE;
+                crc_register = crc_kernel_dispatch.fold(crc_register, data, block_count, kFoldConstants);
+                data += block_count * CRC_FOLD_BLOCK_SIZE;
+                size -= block_count * CRC_FOLD_BLOCK_SIZE;
+            }
+        }
+
+        return UpdateTable(crc_register, data, size);
+    }
+
+    // @brief:  shift whole bytes through the register, eight bytes per step using slicing-by-8
+    // @params: uint32_t crc_register, internal register
+    //          const uint8_t *data
+    //          size_t size, number of bytes
+    // @return: uint32_t, updated internal register
+    // @author: Donghan Xia, 2026/10/17
+    static uint32_t UpdateTable(uint32_t crc_register, const uint8_t *data, size_t size) {
+        while (size >= 8) {
+            uint32_t head_word;
+            memcpy(&head_word, data, sizeof(head_word));
+            if (RefIn) {
+                crc_register ^= head_word;
+                crc_register = kTables.slice[7][crc_register & 0xff]
+                        ^ kTables.slice[6][(crc_register >> 8) & 0xff]
+                        ^ kTables.slice[5][(crc_register >> 16) & 0xff]
+                        ^ kTables.slice[4][crc_register >> 24];
+            } else {
+                crc_register ^= __builtin_bswap32(head_word);
+                crc_register = kTables.slice[7][crc_register >> 24]
+                        ^ kTables.slice[6][(crc_register >> 16) & 0xff]
+                        ^ kTables.slice[5][(crc_register >> 8) & 0xff]
+                        ^ kTables.slice[4][crc_register & 0xff];
+            }
+            crc_register ^= kTables.slice[3][data[4]] ^ kTables.slice[2][data[5]]
+                    ^ kTables.slice[1][data[6]] ^ kTables.slice[0][data[7]];
+
+            data += 8;
+            size -= 8;
+        }
+
+        while (size > 0) {
+            crc_register = UpdateByte(crc_register, *data);
+            data++;
+            size--;
+        }
+
+        return crc_register;
+    }
+
+    // @brief:  shift the leading bits of one byte through the register one bit at a time
+    //          the bits are taken in data order (from the most significant bit of the byte)
+    //          ... for both reflected and non-reflected algorithms
+    // @params: uint32_t crc_register, internal register
+    //          uint8_t bits
+    //          int bit_count, number of bits to shift in (at most 8)
+    // @return: uint32_t, updated internal register
+    // @author: Donghan Xia, 2026/10/17
+    static uint32_t UpdateBits(uint32_t crc_register, uint8_t bits, int bit_count) {
+        for (int bit_index = 0; bit_index < bit_count; bit_index++) {
+            uint32_t data_bit = (bits >> (7 - bit_index)) & 1;
+            crc_register = ShiftBit(crc_register, data_bit);
+        }
+        return crc_register;
+    }
+
+    // @brief:  calculate the CRC value of a byte buffer
+    // @params: const uint8_t *data
+    //          size_t size, number of bytes
+    // @return: uint32_t, CRC value
+    // @author: Donghan Xia, 2026/10/17
+    static uint32_t Compute(const uint8_t *data, size_t size) {
+        return Finalize(Update(Begin(), data, size));
+    }
+
+    // @brief:  calculate the CRC values of many short messages, CRC_MULTI_STREAM_COUNT at a time
+    //          the whole blocks that every message of a group has are folded side by side by the
+    //          ... multi-stream kernel, the rest of each message, groups of messages shorter than
+    //          ... CRC_MULTI_FOLD_MIN_BLOCKS blocks and a partly filled last group go through Update()
+    // @params: const uint8_t *const *messages, the first byte of each message
+    //          const size_t *sizes, number of bytes of each message
+    //          size_t message_count
+    //          uint32_t *crc_values, the pass by reference params to store the CRC values
+    // @return: void
+    // @author: Donghan Xia, 2026/10/17
+    static void ComputeMany(const uint8_t *const *messages, const size_t *sizes, size_t message_count, uint32_t *crc_values) {
+        size_t message_index = 0;
+        // CRC-32C keeps its own instruction
+        bool is_multi_fold = crc_kernel_dispatch.multi_fold != nullptr && !(kIsCrc32c && crc_kernel_dispatch.crc32c != nullptr);
+
+        for (; is_multi_fold && message_index + CRC_MULTI_STREAM_COUNT <= message_count; message_index += CRC_MULTI_STREAM_COUNT) {
+            size_t common_size = *std::min_element(sizes + message_index, sizes + message_index + CRC_MULTI_STREAM_COUNT);
+            size_t block_count = common_size / CRC_FOLD_BLOCK_SIZE;
+
+            uint32_t crc_registers[CRC_MULTI_STREAM_COUNT];
+            std::fill(crc_registers, crc_registers + CRC_MULTI_STREAM_COUNT, Begin());
+            if (block_count >= CRC_MULTI_FOLD_MIN_BLOCKS) {
+                crc_kernel_dispatch.multi_fold(crc_registers, messages + message_index, block_count, kFoldConstants);
+            } else {
+                block_count = 0;
+            }
+
+            size_t folded_size = block_count * CRC_FOLD_BLOCK_SIZE;
+            for (int stream_index = 0; stream_index < CRC_MULTI_STREAM_COUNT; stream_index++) {
+                size_t stream_message_index = message_index + stream_index;
+                crc_values[stream_message_index] = Finalize(Update(crc_registers[stream_index],
+                        messages[stream_message_index] + folded_size, sizes[stream_message_index] - folded_size));
+            }
+        }
+
+        for (; message_index < message_count; message_index++) {
+            crc_values[message_index] = Compute(messages[message_index], sizes[message_index]);
+        }
+    }
+
+    // @brief:  calculate the CRC value of the first bit_count bits of packed data
+    // @params: PackedBits packed_data
+    //          size_t bit_count
+    // @return: uint32_t, CRC value
+    // @author: Donghan Xia, 2026/10/17
+    static uint32_t Compute(const PackedBits &packed_data, size_t bit_count) {
+        size_t full_byte_count = bit_count / 8;
+        int tail_bit_count = bit_count % 8;
+
+        uint32_t crc_register = Update(Begin(), packed_data.Bytes(), full_byte_count);
+        if (tail_bit_count != 0) {
+            crc_register = UpdateBits(crc_register, packed_data.Bytes()[full_byte_count], tail_bit_count);
+        }
+
+        return Finalize(crc_register);
+    }
+
+    // @brief:  calculate the CRC value of packed data
+    // @params: PackedBits packed_data
+    // @return: uint32_t, CRC value
+    // @author: Donghan Xia, 2026/10/17
+    static uint32_t Compute(const PackedBits &packed_data) {
+        return Compute(packed_data, packed_data.bit_count);
+    }
+
+    // @brief:  shift bit_count zero bits through the register in O(log(bit_count)) steps, i.e.
+    //          ... multiply the register by x^bit_count mod P'
+    // @params: uint32_t crc_register, internal register
+    //          uint64_t bit_count
+    // @return: uint32_t, updated internal register
+    // @author: Donghan Xia, 2026/10/17
+    static uint32_t ShiftZeros(uint32_t crc_register, uint64_t bit_count) {
+        for (int power_index = 0; bit_count != 0; power_index++, bit_count >>= 1) {
+            if (bit_count & 1) {
+                crc_register = MultiplyCrcRegister<RefIn>(kShiftTable.power[power_index], crc_register, kRegisterPoly);
+            }
+        }
+        return crc_register;
+    }
+
+    // @brief:  get the register of data A followed by data B from the register of A and the
+    //          ... register of B alone, like zlib's crc32_combine() for any generator
+    //          the register update is linear in GF(2): starting B from the register of A instead of
+    //          ... from zero only adds the register of A shifted over the bits of B
+    // @params: uint32_t crc_register, internal register after data A
+    //          uint32_t chunk_register, internal register after data B starting from a zero register
+    //          uint64_t chunk_bit_count, number of bits of data B
+    // @return: uint32_t, internal register after data A and B
+    // @author: Donghan Xia, 2026/10/17
+    static uint32_t Combine(uint32_t crc_register, uint32_t chunk_register, uint64_t chunk_bit_count) {
+        return ShiftZeros(crc_register, chunk_bit_count) ^ chunk_register;
+    }
+
+    // @brief:  decide if a received codeword (data followed by Width CRC bits) should be accepted
+    //          a codeword shorter than the CRC is accepted only if it is all zeros, which is the
+    //          ... same result as checking the remainder of the mod 2 division
+    // @params: PackedBits packed_data
+    // @return: bool
+    // @author: Donghan Xia, 2026/10/17
+    static bool CheckCodeword(const PackedBits &packed_data) {
+        if (packed_data.bit_count < (size_t) Width) {
+            return ExtractBits(packed_data, 0, packed_data.bit_count) == 0;
+        }
+
+        size_t message_bit_count = packed_data.bit_count - Width;
+        return Compute(packed_data, message_bit_count) == ExtractBits(packed_data, message_bit_count, Width);
+    }
+
+private:
+    static constexpr uint32_t ShiftBit(uint32_t crc_register, uint32_t data_bit) {
+        return ShiftCrcBit<RefIn>(crc_register, data_bit, kRegisterPoly);
+    }
+
+    static constexpr uint32_t UpdateByte(uint32_t crc_register, uint8_t byte_value) {
+        if (RefIn) {
+            return (crc_register >> 8) ^ kTables.slice[0][(crc_register ^ byte_value) & 0xff];
+        }
+        return (crc_register << 8) ^ kTables.slice[0][(crc_register >> 24) ^ byte_value];
+    }
+
+    static constexpr CrcTables kTables = BuildCrcTables<RefIn>(kRegisterPoly);
+    static constexpr CrcShiftTable kShiftTable = BuildCrcShiftTable<RefIn>(kRegisterPoly);
+};
+
+// streaming CRC calculation that keeps nothing but the CRC register, so that data of any length
+// ... can be shifted in piece by piece, e.g. one file chunk at a time
+// Begin() -> Update() ... -> Finalize() yields the same value as CrcType::Compute() on the whole data
+template <typename CrcType>
+class CrcState {
+public:
+    CrcState() : crc_register_(CrcType::Begin()) {}
+
+    explicit CrcState(uint32_t crc_register) : crc_register_(crc_register) {}
+
+    // @brief:  start over with a new message
+    // @params: void
+    // @return: void
+    // @author: Donghan Xia, 2026/10/17
+    void Reset() {
+        crc_register_ = CrcType::Begin();
+    }
+
+    // @brief:  shift the next whole bytes of the message through the register
+    // @params: const uint8_t *data
+    //          size_t size, number of bytes
+    // @return: void
+    // @author: Donghan Xia, 2026/10/17
+    void Update(const uint8_t *data, size_t size) {
+        crc_register_ = CrcType::Update(crc_register_, data, size);
+    }
+
+    // @brief:  shift the first bit_count bits of packed data through the register as the next
+    //          ... piece of the message, only the last piece may end in a partial byte
+    // @params: PackedBits packed_data
+    //          size_t bit_count
+    // @return: void
+    // @author: Donghan Xia, 2026/10/17
+    void Update(const PackedBits &packed_data, size_t bit_count) {
+        size_t full_byte_count = bit_count / 8;
+        int tail_bit_count = bit_count % 8;
+
+        Update(packed_data.Bytes(), full_byte_count);
+        if (tail_bit_count != 0) {
+            crc_register_ = CrcType::UpdateBits(crc_register_, packed_data.Bytes()[full_byte_count], tail_bit_count);
+        }
+    }
+
+    // @brief:  shift all bits of packed data through the register as the next piece of the message
+    // @params: PackedBits packed_data
+    // @return: void
+    // @author: Donghan Xia, 2026/10/17
+    void Update(const PackedBits &packed_data) {
+        Update(packed_data, packed_data.bit_count);
+    }
+
+    // @brief:  get the internal register, e.g. to combine it with registers computed elsewhere
+    // @params: void
+    // @return: uint32_t, internal register
+    // @author: Donghan Xia, 2026/10/17
+    uint32_t GetRegister() const {
+        return crc_register_;
+    }
+
+    // @brief:  get the CRC value of all the data shifted in so far, the state itself is unchanged
+    // @params: void
+    // @return: uint32_t, CRC value
+    // @author: Donghan Xia, 2026/10/17
+    uint32_t Finalize() const {
+        return CrcType::Finalize(crc_register_);
+    }
+
+private:
+    // internal register, see Crc::Begin()
+    uint32_t crc_register_;
+};
+
+// ready-made algorithms, named after the CRC catalogue
+// CRC-8/SMBUS
+typedef Crc<8, 0x07, false, false, 0x00, 0x00> Crc8;
+// CRC-12/DECT, the generator 1100000001111 used by dataTx.txt/dataRx.txt/dataVs.txt
+typedef Crc<12, 0x80f, false, false, 0x000, 0x000> Crc12;
+// CRC-16/CCITT-FALSE
+typedef Crc<16, 0x1021, false, false, 0xffff, 0x0000> Crc16Ccitt;
+// CRC-32/ISO-HDLC, used by Ethernet and zlib
+typedef Crc<32, 0x04c11db7, true, true, 0xffffffff, 0xffffffff> Crc32;
+// CRC-32C/Castagnoli, used by iSCSI and ext4
+typedef Crc<32, 0x1edc6f41, true, true, 0xffffffff, 0xffffffff> Crc32c;
+
+// @brief:  invoke visitor with a value of the CRC algorithm type selected by name, so that the
+//          ... polynomial is chosen once per run and every call inside the visitor is resolved at
+//          ... compile time
+// @params: std::string algorithm_name, one of crc8, crc12, crc16, crc32, crc32c
+//          Visitor visitor, generic lambda that takes the algorithm type as (auto) parameter
+// @return: bool, false if the algorithm name is unknown
+// @author: Donghan Xia, 2026/10/17
+template <typename Visitor>
+bool DispatchCrcAlgorithm(const std::string &algorithm_name, Visitor &&visitor) {
+    if (algorithm_name == "crc8") {
+        visitor(Crc8());
+    } else if (algorithm_name == "crc12") {
+        visitor(Crc12());
+    } else if (algorithm_name == "crc16") {
+        visitor(Crc16Ccitt());
+    } else if (algorithm_name == "crc32") {
+        visitor(Crc32());
+    } else if (algorithm_name == "crc32c") {
+        visitor(Crc32c());
+    } else {
+        return false;
+    }
+    return true;
+}
+
+#endif
@@ -1,149 +1,283 @@
 #include <iostream>
 #include <string>
-#include <fstream>
+#include <string_view>
 #include <cstdlib>
-#include <functional>
+#include <memory>
+#include <map>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <cstdio>
 
+#include "crc_template.h"
+#include "crc_options.h"
+#include "crc_parallel.h"
+#include "crc_stages.h"
+#include "pipeline.h"
+#include "stage_profiler.h"
+#include "mmap_reader.h"
 #include "crc_tx.h"
+// number of batches per worker thread that may be read but not yet written, which bounds the memory
+// ... of the pipeline mode
+#define TX_BATCHES_PER_THREAD 4
 
-// @brief:  implement CRC to source data and show the results in terminal
-// @params: std::string source_data, the original data that are read from dataTx.txt file
-//          std::string generator_data, the CRC-12 generator string
-// @return: void
-// @author: Donghan Xia, 2021/09/19
-void EncodeCrc(std::string source_data, std::string generator_data) {
-    // copy source_data to combine with CRC code to get the final codeword
-    std::string original_data = source_data;
-
-    // calculate the highest digit bit of CRC generator, which refers to the number of CRC result bits
-    int generator_size = generator_data.size();
-    int crc_result_size = generator_size - 1;
-
-    // complement zeros
-    ComplementZeros(source_data, crc_result_size);
-
-    // calculate size of source data that has been applied zeros
-    int source_size = source_data.size();
-
-    // calculate the end-division digit at which the mod 2 division will stop
-    int end_div_digit = source_size - generator_size;
-    
-    // calculate the cut-off digit at witch the applied CRC code starts
-    int crc_cutoff_digit = source_size - crc_result_size;
-    
-    // perform mod 2 division
-    int div_index = 0;
-    while (true) {
-        // upper-bound condition
-        if (div_index > end_div_digit) {
-            break;
-        }
+// @brief:  print the encoded data, only counted unless the results are text
+// @params: PipelineRecord &record, the record after CrcEncode
+// @return: bool, always true
+// @author: Donghan Xia, 2026/10/17
+bool PrintCodeword::Process(PipelineRecord &record) {
+    result_writer_->WriteResult(0, record.line_number, record.check_value, record.check_width, RESULT_ENCODED);
+    if (!result_writer_->IsTextMode()) {
+        return true;
+    }
 
-        for (int iter_index = 0; iter_index < generator_size; iter_index++) {
-            source_data[div_index + iter_index] 
-                    = XorSingleBit(source_data[div_index + iter_index], generator_data[iter_index]);
-        }
-        // make div_index point to next non-zero bit digit
-        FindNextDivDigit(div_index, source_data);
+    line_output_data_.clear();
+    AppendEncodedData(record.source_data, record.check_value, record.check_width, line_output_data_);
+    result_writer_->WriteText(line_output_data_);
+    return true;
+}
+
+// @brief:  append the binary record and its CRC to the output
+// @params: PipelineRecord &record, the record after CrcEncodeBytes
+// @return: bool, always true
+// @author: Donghan Xia, 2026/10/17
+bool WriteCodewordBytes::Process(PipelineRecord &record) {
+    char crc_data[4];
+    int crc_byte_count = (record.check_width + 7) / 8;
+    for (int byte_index = 0; byte_index < crc_byte_count; byte_index++) {
+        crc_data[byte_index] = (char) (record.check_value >> (8 * (crc_byte_count - 1 - byte_index)));
     }
 
-    // print result in terminal
-    std::string crc_result_data = source_data.substr(crc_cutoff_digit);
-    std::cout << "codeword: " << std::endl << original_data + crc_result_data << std::endl;
-    std::cout << "crc: " << std::endl << crc_result_data << std::endl;
+    record_writer_.BeginRecord(record.line_data.size() + crc_byte_count);
+    record_writer_.Write(record.line_data);
+    record_writer_.Write(std::string_view(crc_data, crc_byte_count));
+    return true;
 }
 
-// @brief:  apply zeros at the end of source data to meet the needs of CRC-12 mod2 division
-// @params: std::string &source_data, he pass by reference params to provide the address of source_data
-//          int diff, the number of zeros needed to applying
+// @brief:  write the rest of the output after the last record
+// @params: void
 // @return: void
-// @author: Donghan Xia, 2021/09/19
-void ComplementZeros(std::string &source_data, int diff) {
-    while (true) {
-        // upper-bound condition
-        if (diff == 0) {
-            break;
-        }
-        // apply single zero at the end of source data
-        source_data.append(1, '0');
+// @author: Donghan Xia, 2026/10/17
+void WriteCodewordBytes::Finish() {
+    record_writer_.Flush();
+}
 
-        diff--;
-    }
+// @brief:  append the printed form of one encoded source data to the output text
+// @params: PackedBits source_data
+//          uint32_t crc_value
+//          int crc_width, number of CRC bits
+//          std::string &output_data, the pass by reference params of the output text
+// @return: void
+// @author: Donghan Xia, 2026/10/17
+void AppendEncodedData(const PackedBits &source_data, uint32_t crc_value, int crc_width, std::string &output_data) {
+    std::string crc_result_data = ConvertRemainderToBinary(crc_value, crc_width);
+    output_data += "codeword: \n";
+    output_data += FormatBitString(source_data);
+    output_data += crc_result_data;
+    output_data += "\ncrc: \n";
+    output_data += crc_result_data;
+    output_data += "\n";
 }
 
-// @brief:  make division index points to next division place
-// @params: int &div_index, the pass by reference params to provide the address of division index
-//          std::string, the source data that has already been applied with complementary zeros
-// @return: int index that points to the start digit of next mod 2 division iteration
+// @brief:  read all the transmission datas and then implement CRC to each data code
+//          the whole path is one Pipeline instantiation, so every stage is resolved and can be
+//          ... inlined at compile time
+// @params: WorkStealingPool *pool, thread pool of the parallel mode, nullptr for a single thread
+//          ResultWriter &result_writer, the output of the results
+//          CrcType, the CRC algorithm chosen at compile time
+// @return: void
 // @author: Donghan Xia, 2021/09/19
-void FindNextDivDigit(int &div_index, std::string source_data) {
+template <typename CrcType>
+void TransmitData(WorkStealingPool *pool, ResultWriter &result_writer) {
+    Pipeline<MmapLineSource, ParseBits, CrcEncode<CrcType>, PrintCodeword> pipeline(
+        MmapLineSource("dataTx.txt"), ParseBits(), CrcEncode<CrcType>(pool), PrintCodeword(&result_writer)
+    );
+    pipeline.Run();
+}
+
+// @brief:  binary mode: calculate the CRC of every raw record of a file or stdin and write the
+//          ... record followed by its CRC to stdout, then report the throughput to stderr
+// @params: std::string input_name, "-" for stdin
+//          size_t record_size, number of bytes per record, 0 for the whole input as one record
+//          bool is_framed, whether every codeword is written as a length-prefixed frame
+//          WorkStealingPool *pool, thread pool of the parallel mode, nullptr for a single thread
+//          CrcType, the CRC algorithm chosen at compile time
+// @return: void
+// @author: Donghan Xia, 2026/10/17
+template <typename CrcType>
+void TransmitBinaryData(const std::string &input_name, size_t record_size, bool is_framed, WorkStealingPool *pool) {
+    Pipeline<BinaryRecordSource, CrcEncodeBytes<CrcType>, WriteCodewordBytes, ThroughputSink> pipeline(
+        BinaryRecordSource(input_name, record_size), CrcEncodeBytes<CrcType>(pool), WriteCodewordBytes(is_framed),
+        ThroughputSink()
+    );
+    pipeline.Run();
+}
+
+// @brief:  encode every line of a batch into the results of the batch, lines with any character
+//          ... other than '0' and '1' are reported in the error text of the batch
+// @params: LineBatch &batch, the pass by reference params of the batch
+//          std::string file_name, used in the error messages
+//          CrcType, the CRC algorithm (e.g. Crc12) chosen at compile time
+// @return: void
+// @author: Donghan Xia, 2026/10/17
+template <typename CrcType>
+void EncodeBatch(LineBatch &batch, const std::string &file_name) {
+    // the same stages as TransmitData(), with the source and the outputs of the batch
+    Pipeline<ViewLineSource, ParseBits, CrcEncode<CrcType>, PrintCodeword> pipeline(
+        ViewLineSource(batch.line_data, batch.line_count, batch.first_line_number, file_name),
+        ParseBits(&batch.error_data), CrcEncode<CrcType>(), PrintCodeword(batch.result_writer.get())
+    );
+    pipeline.Run();
+}
+
+// @brief:  writer stage of the pipeline mode, print the encoded batches in the original order
+//          a batch encoded early waits in the queue until all the batches before it are printed
+// @params: BatchQueue &batch_queue, the queue shared with the reader and the workers
+//          ResultWriter &result_writer, the output of the program
+// @return: void
+// @author: Donghan Xia, 2026/10/17
+void WriteBatches(BatchQueue &batch_queue, ResultWriter &result_writer) {
+    size_t batch_index = 0;
+
     while (true) {
-        // upper-bound condition
-        if (div_index >= source_data.size()) {
-            break;
-        }
-        // next non-zero division place condition
-        if (source_data[div_index] == '1') {
-            break;
+        std::shared_ptr<LineBatch> batch;
+        {
+            std::unique_lock<std::mutex> queue_lock(batch_queue.mutex);
+            batch_queue.condition.wait(queue_lock, [&batch_queue, batch_index]() {
+                return batch_queue.encoded_batches.count(batch_index) != 0
+                        || (batch_queue.is_reading_done && batch_index == batch_queue.batch_count);
+            });
+            if (batch_queue.encoded_batches.count(batch_index) == 0) {
+                return;
+            }
+            batch = batch_queue.encoded_batches[batch_index];
+            batch_queue.encoded_batches.erase(batch_index);
         }
 
-        div_index++;
-    }
-}
+        std::cerr << batch->error_data;
+        result_writer.Merge(*batch->result_writer);
 
-// @brief:  bitwise xor operation
-// @params: char first_bit
-//          char second_bit
-// @return: char result of xor operation
-// @author: Donghan Xia, 2021/09/19
-char XorSingleBit(char first_bit, char second_bit) {
-    int result = first_bit xor second_bit;
-    // cast int result to char
-    return result + '0';
+        {
+            std::lock_guard<std::mutex> queue_lock(batch_queue.mutex);
+            batch_queue.in_flight_count--;
+        }
+        batch_queue.condition.notify_all();
+        batch_index++;
+    }
 }
 
-// @brief:  read all the transmission datas from dataTx.txt via infile stream
-// @params: std::function<void(std::string, std::string)>, lambda function that perform actual
-//          ... CRC implementation
+// @brief:  pipeline mode for files with numerous short lines: the reader (the calling thread) splits
+//          ... dataTx.txt into batches of whole lines, the workers of the pool encode the batches in
+//          ... parallel and a writer thread prints them in the original order
+//          a batch is a view into the mapped file, so the reader copies no line, and each worker
+//          ... runs the batch through the same compile-time pipeline as TransmitData()
+// @params: WorkStealingPool &pool, the worker stage
+//          int batch_line_count, number of lines per batch
+//          ResultWriter &result_writer, the output of the results
+//          CrcType, the CRC algorithm chosen at compile time
 // @return: void
-// @author: Donghan Xia, 2021/09/19
-void ReadSourceData(std::function<void (std::string, std::string)> const& InvokeFunc) {
-    // define the CRC-12 generator (Hard-Code)
-    std::string generator_data = "1100000001111";
-    
-    // read dataTx.txt file via infile stream
+// @author: Donghan Xia, 2026/10/17
+template <typename CrcType>
+void TransmitBatches(WorkStealingPool &pool, int batch_line_count, ResultWriter &result_writer) {
     std::string file_name = "dataTx.txt";
-    std::string source_data;
+    BatchQueue batch_queue;
+    size_t max_in_flight_count = (size_t) TX_BATCHES_PER_THREAD * pool.GetThreadCount();
+    std::thread writer_thread(WriteBatches, std::ref(batch_queue), std::ref(result_writer));
+
+    // hand a batch to the workers, wait first if too many batches are not written yet
+    auto submit_batch = [&](std::shared_ptr<LineBatch> batch) {
+        {
+            std::unique_lock<std::mutex> queue_lock(batch_queue.mutex);
+            batch_queue.condition.wait(queue_lock, [&]() {
+                return batch_queue.in_flight_count < max_in_flight_count;
+            });
+            batch_queue.in_flight_count++;
+        }
+        pool.Submit([batch, &batch_queue, &file_name]() {
+            EncodeBatch<CrcType>(*batch, file_name);
+            {
+                std::lock_guard<std::mutex> queue_lock(batch_queue.mutex);
+                batch_queue.encoded_batches[batch->batch_index] = batch;
+            }
+            batch_queue.condition.notify_all();
+        });
+    };
 
-    std::ifstream infile_stream;
-    infile_stream.open(file_name.c_str());
+    // the mapping has to outlive the workers, which read the batches through views into it
+    MmapReader file_reader(file_name);
+    std::string_view line_data;
 
-    // use ifstream::peek() instead of ifstream::eof() to avoid the redundant end-line problem
-    while (infile_stream.peek() != EOF) {
-        // obtain data per line in dataTx.txt
-        std::getline(infile_stream, source_data);
+    // every batch keeps its results in memory until the writer merges them
+    std::shared_ptr<LineBatch> batch = std::make_shared<LineBatch>();
+    batch->first_line_number = 1;
+    batch->result_writer.reset(new ResultWriter(result_writer.GetMode()));
+    while (file_reader.NextLine(line_data)) {
+        // the batch covers its first line through the end of its last line
+        if (batch->line_count == 0) {
+            batch->line_data = line_data;
+        } else {
+            size_t batch_size = line_data.data() + line_data.size() - batch->line_data.data();
+            batch->line_data = std::string_view(batch->line_data.data(), batch_size);
+        }
+        batch->line_count++;
 
-        // utilize erase-type lambda function passed by reference value to make function ReadSourceData
-        // ... decoupled from actual CRC implementation function
-        // TODO: replace erase-type lambda function with function template to avoid considerable runtime
-        // ... due to repeatedly calling erase-type lambda function
-        InvokeFunc(source_data, generator_data);
+        if (batch->line_count == batch_line_count) {
+            std::shared_ptr<LineBatch> next_batch = std::make_shared<LineBatch>();
+            next_batch->batch_index = batch->batch_index + 1;
+            next_batch->first_line_number = batch->first_line_number + batch->line_count;
+            next_batch->result_writer.reset(new ResultWriter(result_writer.GetMode()));
+            submit_batch(batch);
+            batch = next_batch;
+        }
+    }
+    // the last batch may be partly filled
+    size_t batch_count = batch->batch_index;
+    if (batch->line_count > 0) {
+        submit_batch(batch);
+        batch_count++;
     }
 
-    infile_stream.close();
+    {
+        std::lock_guard<std::mutex> queue_lock(batch_queue.mutex);
+        batch_queue.batch_count = batch_count;
+        batch_queue.is_reading_done = true;
+    }
+    batch_queue.condition.notify_all();
+    writer_thread.join();
 }
 
-// @brief:  read all the transmission datas and then implement CRC to each data code
-// @params: void
-// @return: void
-// @author: Donghan Xia, 2021/09/19
-void TransmitData() {
-    ReadSourceData(EncodeCrc);
-}
+int main(int argc, char *argv[]) {
 
-int main() {
+    CrcOptions options = ParseCrcOptions(argc, argv, CRC_TX_OPTIONS);
+    if (options.is_profiling) {
+        EnableStageProfiling();
+    }
 
-    TransmitData();
+    std::unique_ptr<WorkStealingPool> pool;
+    if (options.thread_count != 1 || options.batch_line_count > 0) {
+        pool.reset(new WorkStealingPool(options.thread_count));
+    }
+
+    // the binary mode writes the codewords themselves to stdout instead of the results
+    ResultWriter::Mode result_mode;
+    ParseResultMode(options.result_mode_name, result_mode);
+    ResultWriter result_writer(result_mode, options.input_name.empty() ? options.result_output_name : "", {"crc"});
+
+    // the CRC algorithm is dispatched once, all per-line calls are resolved at compile time
+    DispatchCrcAlgorithm(options.algorithm_name, [&pool, &options, &result_writer](auto crc_algorithm) {
+        if (!options.input_name.empty()) {
+            TransmitBinaryData<decltype(crc_algorithm)>(options.input_name, options.record_size, options.is_framed, pool.get());
+        } else if (options.batch_line_count > 0) {
+            TransmitBatches<decltype(crc_algorithm)>(*pool, options.batch_line_count, result_writer);
+        } else {
+            TransmitData<decltype(crc_algorithm)>(pool.get(), result_writer);
+        }
+    });
+    result_writer.Finish();
+
+    if (options.is_profiling) {
+        PrintStageProfile();
+    }
 
     return 0;
 }
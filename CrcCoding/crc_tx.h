@@ -1,13 +1,86 @@
 #include <iostream>
+#include <string>
+#include <string_view>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
 
-void TransmitData();
+#include "thread_pool.h"
+#include "pipeline.h"
+#include "record_reader.h"
+#include "result_writer.h"
 
-void EncodeCrc(std::string source_data, std::string generator_data);
+// sink: print the codeword and the CRC of each record
+class PrintCodeword : public PipelineStage {
+public:
+    static constexpr ProfileStage kProfileStage = PROFILE_OUTPUT;
 
-void FindNextDivDigit(int &div_index, std::string source_data);
+    // @params: ResultWriter *result_writer, the output of the program or of a batch
+    explicit PrintCodeword(ResultWriter *result_writer) : result_writer_(result_writer) {}
 
-void ReadSourceData(std::function<void (std::string, std::string)> const& InvokeFunc);
+    bool Process(PipelineRecord &record);
 
-char XorSingleBit(char first_bit, char second_bit);
+private:
+    ResultWriter *result_writer_;
+    // text of one record, reused for every record
+    std::string line_output_data_;
+};
 
-void ComplementZeros(std::string &source_data, int diff);
\ No newline at end of file
+// sink: write each binary record followed by its CRC in big-endian bytes to stdout, as one frame if
+// ... framed
+class WriteCodewordBytes : public PipelineStage {
+public:
+    static constexpr ProfileStage kProfileStage = PROFILE_OUTPUT;
+
+    explicit WriteCodewordBytes(bool is_framed) : record_writer_(is_framed) {}
+
+    bool Process(PipelineRecord &record);
+
+    void Finish();
+
+private:
+    RecordWriter record_writer_;
+};
+
+// a batch of whole lines of dataTx.txt that is encoded by one task of the pipeline mode
+struct LineBatch {
+    size_t batch_index = 0;
+    int first_line_number = 0;
+    int line_count = 0;
+    // the lines including the end-lines between them, a view into the mapped dataTx.txt
+    std::string_view line_data;
+    // the results of the lines, merged into the output of the program in order
+    std::unique_ptr<ResultWriter> result_writer;
+    // messages of the skipped lines
+    std::string error_data;
+};
+
+// batches between the reader, the workers and the writer of the pipeline mode
+struct BatchQueue {
+    std::mutex mutex;
+    std::condition_variable condition;
+    // encoded batches that wait for the batches before them to be written
+    std::map<size_t, std::shared_ptr<LineBatch>> encoded_batches;
+    // number of batches read but not written yet
+    size_t in_flight_count = 0;
+    // total number of batches, valid once is_reading_done is set
+    size_t batch_count = 0;
+    bool is_reading_done = false;
+};
+
+template <typename CrcType>
+void TransmitData(WorkStealingPool *pool, ResultWriter &result_writer);
+
+template <typename CrcType>
+void TransmitBinaryData(const std::string &input_name, size_t record_size, bool is_framed, WorkStealingPool *pool);
+
+template <typename CrcType>
+void TransmitBatches(WorkStealingPool &pool, int batch_line_count, ResultWriter &result_writer);
+
+template <typename CrcType>
+void EncodeBatch(LineBatch &batch, const std::string &file_name);
+
+void AppendEncodedData(const PackedBits &source_data, uint32_t crc_value, int crc_width, std::string &output_data);
+
+void WriteBatches(BatchQueue &batch_queue, ResultWriter &result_writer);
@@ -1,473 +1,483 @@
+#include <chrono>
 #include <iostream>
 #include <string>
-#include <functional>
-#include <fstream>
-#include <cmath>
-#include <algorithm>
-
-#include "crc_rx.h"
+#include <string_view>
+#include <vector>
+
+#include "arq_simulator.h"
+#include "checksum_engine.h"
+#include "crc_template.h"
+#include "crc_options.h"
+#include "crc_stages.h"
+#include "monte_carlo.h"
+#include "thread_pool.h"
+#include "pipeline.h"
+#include "stage_profiler.h"
 #include "crc_vs_checksum.h"
 
-// size of each section of checksum calculation
-
-// @brief:  split combo data string into source data string and error bit string
-// @params: std::string combo_data, the original data from each row of dataVs.txt file that contains
-//          ... both source data and error bit data
-// @return: std::pair<std::string, std::string>, pair object with two component string objects
-//          ... to store the source data and the error bit data
-// @author: Donghan Xia, 2021/09/23
-std::pair<std::string, std::string> SplitComboData(std::string combo_data) {
-    std::pair<std::string, std::string> data_pair = std::make_pair("", "");
-
-    // find the position of char ' ' in combo data
-    int split_position = combo_data.find(0x20);
-
-    if (split_position != combo_data.npos) {
-        // implement split action according to the position of char ' '
-        data_pair.first = combo_data.substr(0, split_position);
-        data_pair.second = combo_data.substr(split_position + 1);
-    }
-
-    // std::cout << data_pair.first << std::endl;
-    // std::cout << data_pair.second << std::endl;
-
-    return data_pair;
-}
-
-// @brief:  apply zeros at the end of source data to meet the needs of CRC-12 mod2 division 
-//          ... and checksum calculation
-// @params: std::string &source_data, the pass by reference params to provide the address of source_data
-//          int diff, the number of zeros needed to applying
-// @return: void
-// @author: Donghan Xia, 2021/09/19
-void ComplementZeros(std::string &source_data, int diff) {
-    while (true) {
-        // upper-bound condition
-        if (diff == 0) {
-            break;
-        }
-        // apply single zero at the end of source data
-        source_data.append(1, '0');
-
-        diff--;
-    }
+// @brief:  implement checksum to source data, by default using one's complement method
+//          also, this function will be reused in receiver part of checksum
+//          the source data is complemented with zeros to whole sections, the sections are summed
+//          ... with wraparound and the complement of the sum is the checksum
+// @params: PackedBits source_data
+//          size_t bit_count, number of leading bits of source data to implement checksum to
+//          ChecksumAlgorithm checksum_algorithm, see FindChecksumAlgorithm() in checksum_engine.cpp
+// @return: uint32_t, Checksum result data
+// @author: Donghan Xia, 2021/09/24
+uint32_t EncodeChecksum(const PackedBits &source_data, size_t bit_count, const ChecksumAlgorithm &checksum_algorithm) {
+    // the packed bytes already are the decimal values of the sections, see checksum_engine.cpp
+    return checksum_algorithm.checksum_func(source_data.Bytes(), bit_count);
 }
 
-// @brief:  make division index FindNextDivDigit to next division place
-//          same as the XorSingleBit() function defined in crc_tx.cpp
-// @params: int &div_index, the pass by reference params to provide the address of division index
-//          std::string, the source data that has already been applied with complementary zeros
-// @return: int index that points to the start digit of next mod 2 division iteration
-// @author: Donghan Xia, 2021/09/19
-void FindNextDivDigit(int &div_index, std::string source_data) {
-    while (true) {
-        // upper-bound condition
-        if (div_index >= source_data.size()) {
-            break;
-        }
-        // next non-zero division place condition
-        if (source_data[div_index] == '1') {
-            break;
-        }
+// @brief:  decide if received checksum data should be accepted by checking 
+//          ... whether the checksum of source data section is equal to the the checksum data section
+// @params: PackedBits received_data, the encoded data that has implemented checksum
+//          ChecksumAlgorithm checksum_algorithm, which also decides the size of checksum data in
+//          ... the received data
+// @return: bool, whether the received data should be accepted
+// @author: Donghan Xia, 2021/09/20
+bool CheckChecksum(const PackedBits &received_data, const ChecksumAlgorithm &checksum_algorithm) {
+    int checksum_size = checksum_algorithm.checksum_size;
 
-        div_index++;
-    }
-}
+    // split the received data into two sections: source data and checksum data
+    size_t split_position = received_data.bit_count - checksum_size;
+    uint64_t checksum_data = ExtractBits(received_data, split_position, checksum_size);
 
-// @brief:  bitwise xor operation
-//          same as the XorSingleBit() function defined in crc_tx.cpp
-// @params: char first_bit
-//          char second_bit
-// @return: char result of xor operation
-// @author: Donghan Xia, 2021/09/19
-char XorSingleBit(char first_bit, char second_bit) {
-    int result = first_bit xor second_bit;
-    // cast int result to char
-    return result + '0';
+    // calculate the checksum of the source data section and check if it is equal to the checksum
+    // ... data section
+    return EncodeChecksum(received_data, split_position, checksum_algorithm) == checksum_data;
 }
 
-// @brief:  introduce bits error to the encoded data
-// @params: std::string &encoded_data, the pass by reference params to provide the address of encoded_data
-//          std::string error_bit_data, error_bit_data from dataVs.txt
+// @brief:  show the CRC/checksum check result
+//          same as the CheckRemainder() function defined in crc_rx.cpp
+// @params: bool is_accepted, whether the received data should be accepted
+//          ResultWriter &result_writer, the buffered output of the text
 // @return: void
-// @author: Donghan Xia, 2021/09/23
-void IntroduceErrorBits(std::string &encoded_code, std::string error_bit_data) {
-    // use string::find() in a iteration to find all occurence of error bit that refers to '1'
-    // position of error bit in
-    int error_position = 0;
-    char error_char = '1';
-    while (true) {
-        error_position = error_bit_data.find(error_char, error_position);
-        // non-error break condition
-        if (error_position == error_bit_data.npos) {
-            break;
-        }
-        // upper-bound break condition
-        if (error_position >= error_bit_data.size()) {
-            break;
-        }
-        // std::cout << "error_position: " << error_position << std::endl;
-
-        // perform Xor operation to the encoded data at the current position with '1'
-        encoded_code[error_position] = XorSingleBit(encoded_code[error_position], error_char);
+// @author: Donghan Xia, 2021/09/20
+void CheckRemainder(bool is_accepted, ResultWriter &result_writer) {
+    std::string_view result_words = "result: pass\n";
 
-        // next find() operation will start from current position + 1
-        error_position++;
+    if (!is_accepted) {
+        result_words = "result: not pass\n";
     }
-    // std::cout << "encoded_code with errors: " << encoded_code << std::endl;
 
+    result_writer.WriteText(result_words);
 }
 
-// @brief:  implement checksum and then check the result with introducing error bits
-// @params: std::string combo_data, the original data from each row of dataVs.txt file that contains
-//          ... both source data and error bit data
-//          std::string generator_data, CRC-12 generator data
-// @return: void
-// @author: Donghan Xia, 2021/09/23
-void ImplementChecksumWithCheck(std::string combo_data) {
-    std::string source_data;
-    std::string error_bit_data;
-
-    std::string encoded_data;
-    std::string checksum_data;
-
-    // split to get source data and error bit data
-    std::pair<std::string, std::string> data_pair = SplitComboData(combo_data);
-    source_data = data_pair.first;
-    error_bit_data = data_pair.second;
-
-    // implement checksum 
-    checksum_data = EncodeChecksum(source_data);
-    encoded_data = source_data.append(checksum_data);
-    // std::cout << "encoded data:" << encoded_data << std::endl;
-
-    // introduce random error bits to the encoded_data;
-    IntroduceErrorBits(encoded_data, error_bit_data);
-
-    // check if encoded data should be accepted
-    CheckChecksum(encoded_data, checksum_data.size());
+// @brief:  calculate the checksum of the source data and append it to get the encoded data
+// @params: PipelineRecord &record
+// @return: bool, always true
+// @author: Donghan Xia, 2026/10/17
+bool ChecksumEncode::Process(PipelineRecord &record) {
+    record.check_value = EncodeChecksum(record.source_data, record.source_data.bit_count, checksum_algorithm_);
+    record.check_width = checksum_algorithm_.checksum_size;
+
+    record.encoded_data = record.source_data;
+    AppendBits(record.encoded_data, record.check_value, record.check_width);
+    return true;
 }
 
-// @brief:  implement checksum to source data using decimal method
-//          also, this function will be reused in receiver part of checksum
-// @params: std::string source_data
-//          bool needs_print_result, the boolean params that decides whether the result
-//          ... should be printed in order to reuse this function without repeatedly 
-//          ... printing the checksum result. The default result of this boolean flag is
-//          ... true (as declared in the crc_vs_checksum.h)
-// @return: std::string, Checksum result data
-// @author: Donghan Xia, 2021/09/24
-std::string EncodeChecksum(std::string source_data, bool needs_print_result) {
-    // complement zeros if the number of digits in source data
-    // ... cannot be divided exactly by 8 (number of a single byte)
-    int source_byte_remainder = source_data.size() % 8;
-    if (source_byte_remainder != 0) {
-        ComplementZeros(source_data, source_byte_remainder);
-    }
-
-    // split the source data into several byte sections and convert
-    // ... each of them to decimal format to calculate the sum
-    int split_size = 8;
-    int split_index = 0;
-    int decimal_sum = 0;
-    // store the current section of size 8 data
-    std::string byte_data;
-
-    while (true) {
-        // upper-bound break condition
-        if (split_index >= source_data.size()) {
-            break;
-        }
-        // get current split section
-        byte_data = source_data.substr(split_index, split_size);
-        // convert byte_data to decimal format
-        decimal_sum += ConvertBinaryToDecimal(byte_data);
+// @brief:  decide if the encoded data should be accepted by its checksum
+// @params: PipelineRecord &record
+// @return: bool, always true
+// @author: Donghan Xia, 2026/10/17
+bool ChecksumCheck::Process(PipelineRecord &record) {
+    record.is_accepted = CheckChecksum(record.encoded_data, checksum_algorithm_);
+    return true;
+}
 
-        split_index += split_size;
+// @brief:  show the CRC and its check result, only counted unless the results are text
+// @params: PipelineRecord &record, the record after CrcSyndromeCheck
+// @return: bool, always true
+// @author: Donghan Xia, 2026/10/17
+bool PrintCrcResult::Process(PipelineRecord &record) {
+    result_writer_->WriteResult(VS_CRC_CODE_INDEX, record.line_number, record.check_value, record.check_width,
+            record.is_accepted ? RESULT_PASSED : RESULT_FAILED);
+    if (result_writer_->IsTextMode()) {
+        result_writer_->WriteText("crc : " + ConvertRemainderToBinary(record.check_value, record.check_width) + "  ");
+        CheckRemainder(record.is_accepted, *result_writer_);
     }
+    return true;
+}
 
-    std::string checksum_result = GetBinaryChecksum(decimal_sum, byte_data.size());
-    // std::cout << "decimal sum: " << decimal_sum << std::endl;
-    if (needs_print_result) {
-        std::cout << "checksum: " << checksum_result << "  ";
+// @brief:  show the checksum and its check result, followed by a blank line, only counted unless
+//          ... the results are text
+// @params: PipelineRecord &record, the record after ChecksumCheck
+// @return: bool, always true
+// @author: Donghan Xia, 2026/10/17
+bool PrintChecksumResult::Process(PipelineRecord &record) {
+    result_writer_->WriteResult(VS_CHECKSUM_CODE_INDEX, record.line_number, record.check_value, record.check_width,
+            record.is_accepted ? RESULT_PASSED : RESULT_FAILED);
+    if (result_writer_->IsTextMode()) {
+        result_writer_->WriteText("checksum: " + ConvertRemainderToBinary(record.check_value, record.check_width) + "  ");
+        CheckRemainder(record.is_accepted, *result_writer_);
+        result_writer_->WriteText("\n");
     }
-
-    return checksum_result;
+    return true;
 }
 
-// @brief:  calculate binary checksum data
-// @params: int decimal_sum
-//          int data_size, binary data size that decides the size of binary result data
-// @return: std::string, binary result
-// @author: Donghan Xia, 2021/09/25
-std::string GetBinaryChecksum(int decimal_sum, int data_size) {
-    // wraparound base
-    int decimal_base = pow(2, data_size);
-    int complementary_base = decimal_base - 1;
-    // calculate quotient and remainder of wraparound in decimal method
-    int wrap_sum = decimal_sum / decimal_base + decimal_sum % decimal_base;
-    // decimal result of checksum
-    int decimal_checksum = complementary_base - wrap_sum;
-
-    return ConvertDecimalToBinary(decimal_checksum, data_size);
+// @brief:  implement CRC and checksum to every line of dataVs.txt, introduce the error bits and then
+//          ... check the results
+//          the whole path is one Pipeline instantiation, so every stage is resolved and can be
+//          ... inlined at compile time
+//          the CRC check only looks up the syndromes of the error bits, since the encoded data is
+//          ... a valid codeword before the errors are introduced
+// @params: CrcType, the CRC algorithm (e.g. Crc12) chosen at compile time
+//          ChecksumAlgorithm checksum_algorithm, the checksum compared with the CRC
+//          ResultWriter &result_writer, the output of the results
+// @return: void
+// @author: Donghan Xia, 2021/09/21
+template <typename CrcType>
+void CompareCrcWithChecksum(const ChecksumAlgorithm &checksum_algorithm, ResultWriter &result_writer) {
+    Pipeline<
+        MmapLineSource, ComboSplit,
+        CrcEncode<CrcType>, CrcSyndromeCheck<CrcType>, PrintCrcResult,
+        ChecksumEncode, InjectErrors, ChecksumCheck, PrintChecksumResult
+    > pipeline(
+        MmapLineSource("dataVs.txt"), ComboSplit(),
+        CrcEncode<CrcType>(), CrcSyndromeCheck<CrcType>(), PrintCrcResult(&result_writer),
+        ChecksumEncode(checksum_algorithm), InjectErrors(), ChecksumCheck(checksum_algorithm),
+        PrintChecksumResult(&result_writer)
+    );
+    pipeline.Run();
 }
 
-// @brief:  convert decimal to binary by bitwise division with 2
-// @params: int decimal_data
-//          int data_size, binary data size that decides the size of binary result data
-// @return: std::string, binary result
-// @author: Donghan Xia, 2021/09/25
-std::string ConvertDecimalToBinary(int decimal_data, int data_size) {
-    // build the reversed-digit binary data
-    int current_index = 0;
-    std::string binary_data;
-    char current_remainder;
-    while (true) {
-        // upper-bound break condition
-        if (current_index == data_size) {
-            break;
-        }
-        
-        current_remainder = decimal_data % 2 + '0';
-        decimal_data = decimal_data / 2;
-        // build the binary data string in reverse order
-        binary_data += current_remainder;
-
-        current_index ++;
+// @brief:  get the name of the checksum in the tables, with the word width of one's complement,
+//          ... e.g. "ones16"
+// @params: CrcOptions options
+//          ChecksumAlgorithm checksum_algorithm
+// @return: std::string
+// @author: Donghan Xia, 2026/10/17
+std::string GetChecksumName(const CrcOptions &options, const ChecksumAlgorithm &checksum_algorithm) {
+    if (options.checksum_name == "ones") {
+        return options.checksum_name + std::to_string(checksum_algorithm.checksum_size);
     }
-
-    // reverse the binary data string
-    std::reverse(binary_data.begin(), binary_data.end());
-
-    return binary_data;
-
+    return options.checksum_name;
 }
 
-// @brief:  convert binary data to decimal by bitwise calculation
-// @params: std::string binary_data
-// @return: int, decimal result
-// @author: Donghan Xia, 2021/09/24
-int ConvertBinaryToDecimal(std::string binary_data) {
-    // std::cout << "data size: " << binary_data.size() << std::endl;
-    int decimal_result = 0;
-    int highest_digit = binary_data.size() - 1;
-    for (int binary_index = 0; binary_index < binary_data.size(); binary_index++) {
-        // std::cout << "exp:" << pow(2, highest_digit - binary_index) << std::endl;
-        decimal_result += (binary_data[binary_index] - '0') * pow(2, highest_digit - binary_index);
+// counts of one task of the Monte Carlo mode
+struct MonteCarloCounts {
+    DetectionCounts crc_counts;
+    DetectionCounts checksum_counts;
+};
+
+// @brief:  send one codeword of CRC through the channel model, CRC only depends on the error bits
+//          ... and is checked with their syndrome without encoding any message
+// @params: CrcType, the CRC algorithm chosen at compile time
+//          Xoshiro256 &generator
+//          ErrorModel error_model
+//          CrcSyndromeTable<CrcType> syndrome_table, of codewords of at least codeword_length bits
+//          size_t codeword_length, the message bits and the CRC bits
+//          PackedBits &error_bit_data, reused by every call
+// @return: ChannelOutcome
+// @author: Donghan Xia, 2026/10/17
+template <typename CrcType>
+ChannelOutcome TransmitCrcCodeword(Xoshiro256 &generator, const ErrorModel &error_model,
+        const CrcSyndromeTable<CrcType> &syndrome_table, size_t codeword_length, PackedBits &error_bit_data) {
+    if (GenerateErrorBits(generator, error_model, codeword_length, error_bit_data) == 0) {
+        return CHANNEL_INTACT;
     }
-
-    return decimal_result;
+    return syndrome_table.GetSyndrome(error_bit_data, codeword_length) == 0 ? CHANNEL_UNDETECTED : CHANNEL_DETECTED;
 }
 
-// @brief:  decide if received checksum data should be accepted by checking 
-//          ... whether the checksum of source data section is equal to the the checksum data section
-// @params: std::string received_data, the encoded data that has implemented checksum
-//          int checksum_size, size of checksum data in the received data 
-// @return: void
-// @author: Donghan Xia, 2021/09/20
-void CheckChecksum(std::string received_data, int checksum_size) {
-    std::string original_data = received_data;
-    // split the received data into two sections: source data and checksum data
-    int split_position = received_data.size() - checksum_size;
-    std::string source_data = received_data.substr(0, split_position);
-    std::string checksum_data = received_data.substr(split_position);
-
-    // std::cout << "source_data: " << source_data << std::endl;
-    // std::cout << "checksum_data: " << checksum_data << std::endl;
-
-    // calculate the checksum of the source data section and check if it is equal to the checksum
-    // ... data section
-    std::string result_word = "pass";
-    if (EncodeChecksum(source_data, false) != checksum_data) {
-        result_word = "not pass";
+// @brief:  send one codeword of checksum through the channel model: encode a random message,
+//          ... introduce the error bits and check it, the checksum of one's complement or Fletcher
+//          ... depends on the data, so the message is random as well instead of all zeros
+// @params: Xoshiro256 &generator
+//          ErrorModel error_model
+//          size_t message_length
+//          ChecksumAlgorithm checksum_algorithm
+//          PackedBits &source_data, reused by every call like the two below
+//          PackedBits &encoded_data
+//          PackedBits &error_bit_data
+// @return: ChannelOutcome
+// @author: Donghan Xia, 2026/10/17
+ChannelOutcome TransmitChecksumCodeword(Xoshiro256 &generator, const ErrorModel &error_model, size_t message_length,
+        const ChecksumAlgorithm &checksum_algorithm, PackedBits &source_data, PackedBits &encoded_data,
+        PackedBits &error_bit_data) {
+    FillRandomBits(generator, message_length, source_data);
+    encoded_data = source_data;
+    AppendBits(encoded_data, EncodeChecksum(source_data, message_length, checksum_algorithm),
+            checksum_algorithm.checksum_size);
+    if (GenerateErrorBits(generator, error_model, encoded_data.bit_count, error_bit_data) == 0) {
+        return CHANNEL_INTACT;
     }
-    
-    std::cout << "result: " << result_word << std::endl << std::endl;
+    XorBits(encoded_data, error_bit_data);
+    return CheckChecksum(encoded_data, checksum_algorithm) ? CHANNEL_UNDETECTED : CHANNEL_DETECTED;
 }
 
-// @brief:  decide if received CRC data should be accepted by checking 
-//          ... whether its mod 2 division result can be divided exactly (remainder is a zero sequence)
-//          same as the CheckCrc() function defined in crc_rx.cpp
-// @params: std::string received_data, the encoded data that has implemented CRC
-//          std::string generator_data, the CRC-12 generator string
+// @brief:  add the outcome of one trial to the counts of a code
+// @params: ChannelOutcome outcome
+//          DetectionCounts &counts, the pass by reference params of the counts
 // @return: void
-// @author: Donghan Xia, 2021/09/20
-void CheckCrc(std::string received_data, std::string generator_data) {
-    std::string original_data = received_data;
-
-    // calculate the highest digit bit of CRC generator
-    int generator_size = generator_data.size();
-
-    // calculate size of received data
-    int received_size = received_data.size();
-
-    // calculate the end-division digit at which the mod 2 division will stop
-    int end_div_digit = received_size - generator_size;
-    
-    // perform mod 2 division
-    int div_index = 0;
-    while (true) {
-        // upper-bound condition
-        if (div_index > end_div_digit) {
-            break;
-        }
+// @author: Donghan Xia, 2026/10/17
+static inline void CountOutcome(ChannelOutcome outcome, DetectionCounts &counts) {
+    counts.error_count += outcome != CHANNEL_INTACT;
+    counts.undetected_count += outcome == CHANNEL_UNDETECTED;
+}
 
-        for (int iter_index = 0; iter_index < generator_size; iter_index++) {
-            received_data[div_index + iter_index] 
-                    = XorSingleBit(received_data[div_index + iter_index], generator_data[iter_index]);
-        }
-        // make div_index point to next non-zero bit digit
-        FindNextDivDigit(div_index, received_data);
+// @brief:  run trials of the Monte Carlo mode with the task's own random generator: encode a random
+//          ... message with CRC and with checksum, introduce the error bits of the channel model into
+//          ... each encoded data and count the errors each code accepted
+// @params: CrcType, the CRC algorithm chosen at compile time
+//          uint64_t trial_count
+//          uint64_t task_seed
+//          ErrorModel error_model
+//          size_t message_length
+//          ChecksumAlgorithm checksum_algorithm
+// @return: MonteCarloCounts
+// @author: Donghan Xia, 2026/10/17
+template <typename CrcType>
+MonteCarloCounts SimulateTrials(uint64_t trial_count, uint64_t task_seed, const ErrorModel &error_model,
+        size_t message_length, const ChecksumAlgorithm &checksum_algorithm) {
+    Xoshiro256 generator(task_seed);
+    MonteCarloCounts counts;
+    size_t crc_codeword_length = message_length + CrcType::kWidth;
+    CrcSyndromeTable<CrcType> syndrome_table(crc_codeword_length);
+    // reused by every trial
+    PackedBits source_data;
+    PackedBits encoded_data;
+    PackedBits error_bit_data;
+
+    for (uint64_t trial_index = 0; trial_index < trial_count; trial_index++) {
+        CountOutcome(TransmitCrcCodeword<CrcType>(generator, error_model, syndrome_table, crc_codeword_length,
+                error_bit_data), counts.crc_counts);
+        CountOutcome(TransmitChecksumCodeword(generator, error_model, message_length, checksum_algorithm,
+                source_data, encoded_data, error_bit_data), counts.checksum_counts);
     }
 
-    CheckRemainder(received_data);
-
+    return counts;
 }
 
-// @brief:  check if the remainder has char '1'
-//          if has, the CRC result is "not pass" because the received data cannot be diveded exactly
-//          if not, the CRC result is "pass"
-//          same as the CheckRemainder() function defined in crc_rx.cpp
-// @params: std::string, the received data
+// @brief:  Monte Carlo mode: compare CRC with checksum on random trials generated in the process
+//          the trials are split into tasks of MONTE_CARLO_TASK_TRIALS run by the thread pool, every
+//          ... task seeds its own xoshiro generator from the seed and its index, so the counts only
+//          ... depend on the seed
+// @params: CrcType, the CRC algorithm chosen at compile time
+//          CrcOptions options
+//          ChecksumAlgorithm checksum_algorithm
 // @return: void
-// @author: Donghan Xia, 2021/09/20
-void CheckRemainder(std::string result_data) {
-    std::string result_words = "pass";
-
-    // use string::find() to locate the position of char '1'
-    // string::find() will return to a static value which refers to string::npos
-    // ... when there is no char '1' in the given string
-    if (result_data.find('1') != result_data.npos) {
-        result_words = "not pass";
+// @author: Donghan Xia, 2026/10/17
+template <typename CrcType>
+void SimulateCrcWithChecksum(const CrcOptions &options, const ChecksumAlgorithm &checksum_algorithm) {
+    ErrorModel error_model;
+    ParseErrorModel(options.error_model_name, error_model);
+    WorkStealingPool pool(options.has_thread_count ? options.thread_count : 0);
+
+    uint64_t task_count = (options.trial_count + MONTE_CARLO_TASK_TRIALS - 1) / MONTE_CARLO_TASK_TRIALS;
+    std::vector<MonteCarloCounts> task_counts(task_count);
+
+    auto start_time = std::chrono::steady_clock::now();
+    pool.ParallelFor(task_count, [&](size_t task_index) {
+        uint64_t trial_count = std::min(MONTE_CARLO_TASK_TRIALS, options.trial_count - task_index * MONTE_CARLO_TASK_TRIALS);
+        task_counts[task_index] = SimulateTrials<CrcType>(trial_count, GetTaskSeed(options.seed, task_index),
+                error_model, options.message_length, checksum_algorithm);
+    });
+    double elapsed_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+
+    MonteCarloCounts total_counts;
+    for (const MonteCarloCounts &counts : task_counts) {
+        total_counts.crc_counts.error_count += counts.crc_counts.error_count;
+        total_counts.crc_counts.undetected_count += counts.crc_counts.undetected_count;
+        total_counts.checksum_counts.error_count += counts.checksum_counts.error_count;
+        total_counts.checksum_counts.undetected_count += counts.checksum_counts.undetected_count;
     }
 
-    std::cout << "result: " << result_words << std::endl;
+    std::cout << "trials: " << options.trial_count << "  message bits: " << options.message_length
+            << "  errors: " << options.error_model_name << "  seed: " << options.seed
+            << "  threads: " << pool.GetThreadCount() << std::endl;
+    std::cout << "code       erroneous trials       undetected  rate       95% confidence interval" << std::endl;
+    PrintDetectionCounts(options.algorithm_name, total_counts.crc_counts);
+    PrintDetectionCounts(GetChecksumName(options, checksum_algorithm), total_counts.checksum_counts);
+    std::cout << "time: " << elapsed_seconds << " s  (" << options.trial_count / elapsed_seconds << " trials/s)" << std::endl;
 }
 
-// @brief:  implement CRC to source data
-// @params: std::string source_data, original data that are read from dataTx.txt file
-//          std::string generator_data, the CRC-12 generator string
-// @return: std::string, CRC result data
-// @author: Donghan Xia, 2021/09/23
-std::string EncodeCrc(std::string source_data, std::string generator_data) {
-    // copy source_data to combine with CRC code to get the final codeword
-    std::string original_data = source_data;
-
-    // calculate the highest digit bit of CRC generator, which refers to the number of CRC result bits
-    int generator_size = generator_data.size();
-    int crc_result_size = generator_size - 1;
-
-    // complement zeros
-    ComplementZeros(source_data, crc_result_size);
-
-    // calculate size of source data that has been applied zeros
-    int source_size = source_data.size();
-
-    // calculate the end-division digit at which the mod 2 division will stop
-    int end_div_digit = source_size - generator_size;
-    
-    // calculate the cut-off digit at witch the applied CRC code starts
-    int crc_cutoff_digit = source_size - crc_result_size;
-    
-    // perform mod 2 division
-    int div_index = 0;
-    while (true) {
-        // upper-bound condition
-        if (div_index > end_div_digit) {
-            break;
-        }
-
-        for (int iter_index = 0; iter_index < generator_size; iter_index++) {
-            source_data[div_index + iter_index] 
-                    = XorSingleBit(source_data[div_index + iter_index], generator_data[iter_index]);
-        }
-        // make div_index point to next non-zero bit digit
-        FindNextDivDigit(div_index, source_data);
+// @brief:  run one task of the ARQ mode with its own random generator: every frame carries a
+//          ... random message of the header and the payload, coded with CRC or with checksum, and
+//          ... every transmission of it goes through the channel model
+// @params: CrcType, the CRC algorithm chosen at compile time
+//          ArqProtocol protocol
+//          ArqLink link, its frame_bit_count is set here
+//          int code_index, VS_CRC_CODE_INDEX or VS_CHECKSUM_CODE_INDEX
+//          uint64_t frame_count, payloads to deliver
+//          uint64_t task_seed
+//          ErrorModel error_model
+//          size_t payload_length
+//          ChecksumAlgorithm checksum_algorithm
+// @return: ArqCounts
+// @author: Donghan Xia, 2026/10/17
+template <typename CrcType>
+ArqCounts SimulateArqTask(const ArqProtocol &protocol, ArqLink link, int code_index, uint64_t frame_count,
+        uint64_t task_seed, const ErrorModel &error_model, size_t payload_length, const ChecksumAlgorithm &checksum_algorithm) {
+    Xoshiro256 generator(task_seed);
+    size_t message_length = ARQ_HEADER_BITS + payload_length;
+    // reused by every transmission
+    PackedBits source_data;
+    PackedBits encoded_data;
+    PackedBits error_bit_data;
+
+    if (code_index == VS_CRC_CODE_INDEX) {
+        size_t codeword_length = message_length + CrcType::kWidth;
+        CrcSyndromeTable<CrcType> syndrome_table(codeword_length);
+        link.frame_bit_count = codeword_length;
+        return ArqSimulator(protocol, link).Run(frame_count, [&]() {
+            return TransmitCrcCodeword<CrcType>(generator, error_model, syndrome_table, codeword_length, error_bit_data);
+        });
     }
 
-    std::string crc_result_data = source_data.substr(crc_cutoff_digit);
-    // std::cout << "codeword: " << std::endl << original_data + crc_result_data << std::endl;
-    std::cout << "crc : " << crc_result_data << "  ";
-    
-    return crc_result_data;
+    link.frame_bit_count = message_length + checksum_algorithm.checksum_size;
+    return ArqSimulator(protocol, link).Run(frame_count, [&]() {
+        return TransmitChecksumCodeword(generator, error_model, message_length, checksum_algorithm, source_data,
+                encoded_data, error_bit_data);
+    });
 }
 
-// @brief:  implement CRC and then check the result with introducing error bits
-// @params: std::string combo_data, the original data from each row of dataVs.txt file that contains
-//          ... both source data and error bit data
-//          std::string generator_data, CRC-12 generator data
+// @brief:  print one row of the ARQ table: the frame bits, the transmissions per payload, the goodput
+//          ... (bits/s of payloads delivered without errors) and its share of the link rate, and the
+//          ... residual error rate of the delivered payloads with its 95% confidence interval
+// @params: std::string error_model_name
+//          int payload_length
+//          std::string code_name
+//          size_t frame_bit_count
+//          ArqCounts counts
+//          double link_bit_rate
+//          bool is_best, whether the code has the best goodput at this payload length
 // @return: void
-// @author: Donghan Xia, 2021/09/23
-void ImplementCrcWithCheck(
-    std::string combo_data, 
-    std::string generator_data) {
-
-    std::string source_data;
-    std::string error_bit_data;
-
-    std::string encoded_data;
-    std::string crc_result_data;
-
-    // split to get source data and error bit data
-    std::pair<std::string, std::string> data_pair = SplitComboData(combo_data);
-    source_data = data_pair.first;
-    error_bit_data = data_pair.second;
-
-    // implement CRC
-    crc_result_data = EncodeCrc(source_data, generator_data);
-    // encoded_data can be obtained by appending CRC code to the original data
-    encoded_data = source_data.append(crc_result_data);
-    // std::cout << "encoded data:" << encoded_data << std::endl;
-
-    // introduce random error bits to the encoded_data;
-    IntroduceErrorBits(encoded_data, error_bit_data);
-
-    // check if encoded data should be accepted
-    CheckCrc(encoded_data, generator_data);
+// @author: Donghan Xia, 2026/10/17
+void PrintArqCounts(const std::string &error_model_name, int payload_length, const std::string &code_name,
+        size_t frame_bit_count, const ArqCounts &counts, double link_bit_rate, bool is_best) {
+    double goodput = GetArqGoodput(counts, payload_length);
+    double lower_bound = 0;
+    double upper_bound = 0;
+    GetWilsonInterval(counts.corrupted_count, counts.delivered_count, lower_bound, upper_bound);
+
+    char row_data[200];
+    snprintf(row_data, sizeof(row_data), "%-12s %8d  %-10s %6zu %9.4f %16.4e %8.2f%% %10llu  %.3e  [%.3e, %.3e]%s",
+            error_model_name.c_str(), payload_length, code_name.c_str(), frame_bit_count,
+            counts.delivered_count > 0 ? (double) counts.transmission_count / counts.delivered_count : 0.0,
+            goodput, 100.0 * goodput / link_bit_rate, (unsigned long long) counts.corrupted_count,
+            counts.delivered_count > 0 ? (double) counts.corrupted_count / counts.delivered_count : 0.0,
+            lower_bound, upper_bound, is_best ? "  *" : "");
+    std::cout << row_data << std::endl;
 }
 
-// @brief:  read all the datas from dataVs.txt via infile stream
-// @params: std::function<void(std::string, std::string)>, lambda function that perform actual
-//          ... CRC implementation and CRC check
-//          std::function<void(std::string)>, lambda function that perform actual checksum
-//          ... implementation and check
+// @brief:  ARQ mode: compare the goodput of CRC and checksum under an ARQ protocol for every channel
+//          ... model of "-e" and every payload length of "-l"
+//          every point of the grid is split into tasks of ARQ_TASK_FRAMES payloads, and the tasks of
+//          ... all the points run on the thread pool together; a task is seeded from the seed, the
+//          ... channel model, the payload length and its index, so both codes see the same seeds and
+//          ... the counts do not depend on the number of threads
+// @params: CrcType, the CRC algorithm chosen at compile time
+//          CrcOptions options
+//          ChecksumAlgorithm checksum_algorithm
 // @return: void
-// @author: Donghan Xia, 2021/09/21
-void ReadSourceData(
-    std::function<void (std::string, std::string)> const& InvokeCrcFunc, 
-    std::function<void (std::string)> const& InvokeChecksumFunc) {
-    // define the CRC-12 generator (Hard-Code)
-    std::string generator_data = "1100000001111";
-    
-    // read dataTx.txt file via infile stream
-    std::string file_name = "dataVs.txt";
-    // combo_data should contains both source data and error bit data
-    // ... which can be split by char ' ' (0x20)
-    std::string combo_data;
-
-    std::ifstream infile_stream;
-    infile_stream.open(file_name.c_str());
-
-    // use ifstream::peek() instead of ifstream::eof() to avoid the redundant end-line problem
-    while (infile_stream.peek() != EOF) {
-        // obtain data per line in dataTx.txt
-        std::getline(infile_stream, combo_data);
-
-        // utilize erase-type lambda function passed by reference value to make function ReadSourceData
-        // ... decoupled from actual CRC encode/decode function and actual checksum encode/decode function
-        // TODO: replace erase-type lambda function with function template to avoid considerable runtime
-        // ... due to repeatedly calling erase-type lambda function
-        InvokeCrcFunc(combo_data, generator_data);
-
-        InvokeChecksumFunc(combo_data);
+// @author: Donghan Xia, 2026/10/17
+template <typename CrcType>
+void SimulateArqGoodput(const CrcOptions &options, const ChecksumAlgorithm &checksum_algorithm) {
+    ArqProtocol protocol;
+    ParseArqProtocol(options.arq_protocol_name, protocol);
+    ArqLink link;
+    link.bit_rate = options.link_bit_rate;
+    link.propagation_delay = options.link_delay;
+    std::vector<ErrorModel> error_models(options.error_model_names.size());
+    for (size_t model_index = 0; model_index < error_models.size(); model_index++) {
+        ParseErrorModel(options.error_model_names[model_index], error_models[model_index]);
+    }
+    WorkStealingPool pool(options.has_thread_count ? options.thread_count : 0);
+
+    uint64_t frame_count = options.trial_count > 0 ? options.trial_count : DEFAULT_ARQ_FRAME_COUNT;
+    uint64_t task_count = (frame_count + ARQ_TASK_FRAMES - 1) / ARQ_TASK_FRAMES;
+    size_t length_count = options.message_lengths.size();
+    // point (model_index * length_count + length_index) * 2 + code_index
+    size_t point_count = error_models.size() * length_count * 2;
+    std::vector<ArqCounts> task_counts(point_count * task_count);
+
+    auto start_time = std::chrono::steady_clock::now();
+    pool.ParallelFor(task_counts.size(), [&](size_t task_index) {
+        size_t point_index = task_index / task_count;
+        size_t seed_index = point_index / 2 * task_count + task_index % task_count;
+        size_t model_index = point_index / 2 / length_count;
+        task_counts[task_index] = SimulateArqTask<CrcType>(protocol, link, (int) (point_index % 2),
+                std::min(ARQ_TASK_FRAMES, frame_count - task_index % task_count * ARQ_TASK_FRAMES),
+                GetTaskSeed(options.seed, seed_index), error_models[model_index],
+                options.message_lengths[point_index / 2 % length_count], checksum_algorithm);
+    });
+    double elapsed_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+
+    // the tasks of a point run one after another on the same link
+    std::vector<ArqCounts> point_counts(point_count);
+    for (size_t task_index = 0; task_index < task_counts.size(); task_index++) {
+        ArqCounts &counts = point_counts[task_index / task_count];
+        counts.delivered_count += task_counts[task_index].delivered_count;
+        counts.corrupted_count += task_counts[task_index].corrupted_count;
+        counts.transmission_count += task_counts[task_index].transmission_count;
+        counts.elapsed_time += task_counts[task_index].elapsed_time;
     }
 
-    infile_stream.close();
+    std::cout << "arq: " << options.arq_protocol_name << "  link: " << link.bit_rate << " bits/s  delay: "
+            << link.propagation_delay << " s  header: " << ARQ_HEADER_BITS << " bits  payloads: " << frame_count
+            << " per point  seed: " << options.seed << "  threads: " << pool.GetThreadCount() << std::endl;
+    std::cout << "errors        payload  code        frame  tx/frame  goodput (bits/s) efficiency   residual  rate"
+            << "       95% confidence interval" << std::endl;
+    const std::string code_names[2] = {options.algorithm_name, GetChecksumName(options, checksum_algorithm)};
+    const size_t check_widths[2] = {(size_t) CrcType::kWidth, (size_t) checksum_algorithm.checksum_size};
+
+    for (size_t model_index = 0; model_index < error_models.size(); model_index++) {
+        // the code and payload length with the best goodput under this channel model
+        size_t best_point_index = model_index * length_count * 2;
+        double best_goodput = -1;
+        for (size_t length_index = 0; length_index < length_count; length_index++) {
+            int payload_length = options.message_lengths[length_index];
+            size_t point_index = (model_index * length_count + length_index) * 2;
+            double goodputs[2] = {GetArqGoodput(point_counts[point_index], payload_length),
+                    GetArqGoodput(point_counts[point_index + 1], payload_length)};
+
+            for (int code_index = 0; code_index < 2; code_index++) {
+                PrintArqCounts(options.error_model_names[model_index], payload_length, code_names[code_index],
+                        ARQ_HEADER_BITS + payload_length + check_widths[code_index], point_counts[point_index + code_index],
+                        link.bit_rate, goodputs[code_index] >= goodputs[1 - code_index]);
+                if (goodputs[code_index] > best_goodput) {
+                    best_goodput = goodputs[code_index];
+                    best_point_index = point_index + code_index;
+                }
+            }
+        }
+        std::cout << "best at " << options.error_model_names[model_index] << ": " << code_names[best_point_index % 2]
+                << " with " << options.message_lengths[best_point_index / 2 % length_count] << "-bit payloads, "
+                << best_goodput << " bits/s" << std::endl;
+    }
+    std::cout << "time: " << elapsed_seconds << " s" << std::endl;
 }
 
-int main() {
+int main(int argc, char *argv[]) {
 
-    ReadSourceData(ImplementCrcWithCheck, ImplementChecksumWithCheck);
+    CrcOptions options = ParseCrcOptions(argc, argv, CRC_VS_CHECKSUM_OPTIONS);
+    if (options.is_profiling) {
+        EnableStageProfiling();
+    }
+
+    ChecksumAlgorithm checksum_algorithm;
+    FindChecksumAlgorithm(options.checksum_name, options.checksum_width, checksum_algorithm);
+
+    ResultWriter::Mode result_mode;
+    ParseResultMode(options.result_mode_name, result_mode);
+    ResultWriter result_writer(result_mode, options.result_output_name, {"crc", "checksum"});
+
+    // the CRC algorithm is dispatched once, all per-line calls are resolved at compile time
+    DispatchCrcAlgorithm(options.algorithm_name, [&options, &checksum_algorithm, &result_writer](auto crc_algorithm) {
+        if (!options.arq_protocol_name.empty()) {
+            SimulateArqGoodput<decltype(crc_algorithm)>(options, checksum_algorithm);
+        } else if (options.trial_count > 0) {
+            SimulateCrcWithChecksum<decltype(crc_algorithm)>(options, checksum_algorithm);
+        } else {
+            CompareCrcWithChecksum<decltype(crc_algorithm)>(checksum_algorithm, result_writer);
+            result_writer.Finish();
+        }
+    });
+
+    if (options.is_profiling) {
+        PrintStageProfile();
+    }
 
     return 0;
-}
\ No newline at end of file
+}
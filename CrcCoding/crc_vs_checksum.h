@@ -1,36 +1,70 @@
 #include <iostream>
 
-void ReadSourceData(
-    std::function<void (std::string, std::string)> const& InvokeCrcFunc, 
-    std::function<void (std::string)> const& InvokeChecksumFunc
-);
+#include "checksum_engine.h"
+#include "pipeline.h"
+#include "result_writer.h"
 
-std::string EncodeCrc(std::string source_data, std::string generator_data);
+// code indexes of the results, see ResultWriter
+#define VS_CRC_CODE_INDEX 0
+#define VS_CHECKSUM_CODE_INDEX 1
 
-void FindNextDivDigit(int &div_index, std::string source_data);
+// stage: calculate the checksum of the source data and append it to get the encoded data
+class ChecksumEncode : public PipelineStage {
+public:
+    static constexpr ProfileStage kProfileStage = PROFILE_ENCODE;
 
-void ImplementCrcWithCheck(std::string source_data, std::string generator_data);
+    explicit ChecksumEncode(const ChecksumAlgorithm &checksum_algorithm) : checksum_algorithm_(checksum_algorithm) {}
 
-void ImplementChecksumWithCheck(std::string source_data);
+    bool Process(PipelineRecord &record);
 
-char XorSingleBit(char first_bit, char second_bit);
+private:
+    ChecksumAlgorithm checksum_algorithm_;
+};
 
-void ComplementZeros(std::string &source_data, int diff);
+// stage: decide if the encoded data should be accepted by its checksum
+class ChecksumCheck : public PipelineStage {
+public:
+    static constexpr ProfileStage kProfileStage = PROFILE_CHECK;
 
-void IntroduceErrorBits(std::string &source_data, std::string bit_error_data);
+    explicit ChecksumCheck(const ChecksumAlgorithm &checksum_algorithm) : checksum_algorithm_(checksum_algorithm) {}
 
-void CheckCrc(std::string received_data, std::string generator_data);
+    bool Process(PipelineRecord &record);
 
-void CheckRemainder(std::string result_data);
+private:
+    ChecksumAlgorithm checksum_algorithm_;
+};
 
-std::string EncodeChecksum(std::string source_data, bool needs_print_result = true);
+// sink: print the CRC and its check result
+class PrintCrcResult : public PipelineStage {
+public:
+    static constexpr ProfileStage kProfileStage = PROFILE_OUTPUT;
 
-void CheckChecksum(std::string received_data, int checksum_size);
+    explicit PrintCrcResult(ResultWriter *result_writer) : result_writer_(result_writer) {}
 
-int ConvertBinaryToDecimal(std::string binary_data);
+    bool Process(PipelineRecord &record);
 
-std::string ConvertDecimalToBinary(int decimal_data, int data_size);
+private:
+    ResultWriter *result_writer_;
+};
 
-std::string GetBinaryChecksum(int decimal_sum, int base);
+// sink: print the checksum and its check result
+class PrintChecksumResult : public PipelineStage {
+public:
+    static constexpr ProfileStage kProfileStage = PROFILE_OUTPUT;
 
-std::pair<std::string, std::string> SplitComboData(std::string combo_data);
+    explicit PrintChecksumResult(ResultWriter *result_writer) : result_writer_(result_writer) {}
+
+    bool Process(PipelineRecord &record);
+
+private:
+    ResultWriter *result_writer_;
+};
+
+template <typename CrcType>
+void CompareCrcWithChecksum(const ChecksumAlgorithm &checksum_algorithm, ResultWriter &result_writer);
+
+void CheckRemainder(bool is_accepted, ResultWriter &result_writer);
+
+uint32_t EncodeChecksum(const PackedBits &source_data, size_t bit_count, const ChecksumAlgorithm &checksum_algorithm);
+
+bool CheckChecksum(const PackedBits &received_data, const ChecksumAlgorithm &checksum_algorithm);
\ No newline at end of file
@@ -0,0 +1,275 @@
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "crc_template.h"
+#include "thread_pool.h"
+#include "crc_weights.h"
+
+// @brief:  parse a generator polynomial given as its coefficients from the highest one, e.g.
+//          ... 1100000001111 for x^12 + x^11 + x^3 + x^2 + x + 1
+// @params: std::string generator_data
+//          GeneratorPolynomial &generator, the pass by reference params to store the result
+// @return: bool, false if it is not a bit string starting with 1 of degree 1 to 32
+// @author: Donghan Xia, 2026/10/17
+bool ParseGeneratorPolynomial(const std::string &generator_data, GeneratorPolynomial &generator) {
+    if (generator_data.size() < 2 || generator_data.size() > 33 || generator_data[0] != '1') {
+        return false;
+    }
+
+    generator.poly_value = 0;
+    for (char bit_char : generator_data) {
+        if (bit_char != '0' && bit_char != '1') {
+            return false;
+        }
+        generator.poly_value = (generator.poly_value << 1) | (bit_char - '0');
+    }
+    generator.degree = generator_data.size() - 1;
+
+    return true;
+}
+
+// @brief:  get the generator polynomial of a CRC algorithm
+// @params: std::string algorithm_name, see DispatchCrcAlgorithm() in crc_template.h
+//          GeneratorPolynomial &generator, the pass by reference params to store the result
+// @return: bool, false if the algorithm name is unknown
+// @author: Donghan Xia, 2026/10/17
+bool FindAlgorithmGenerator(const std::string &algorithm_name, GeneratorPolynomial &generator) {
+    return DispatchCrcAlgorithm(algorithm_name, [&generator](auto crc_algorithm) {
+        typedef decltype(crc_algorithm) CrcType;
+        generator.poly_value = ((uint64_t) 1 << CrcType::kWidth) | CrcType::kPoly;
+        generator.degree = CrcType::kWidth;
+    });
+}
+
+// @brief:  convert a generator polynomial back to its coefficients from the highest one
+// @params: GeneratorPolynomial generator
+// @return: std::string
+// @author: Donghan Xia, 2026/10/17
+std::string FormatGeneratorPolynomial(const GeneratorPolynomial &generator) {
+    std::string generator_data;
+    for (int power = generator.degree; power >= 0; power--) {
+        generator_data += (generator.poly_value >> power) & 1 ? '1' : '0';
+    }
+    return generator_data;
+}
+
+// @brief:  get the syndrome of every single error bit of a codeword, i.e. x^d mod G for the bit d
+//          ... bits before the end of the codeword
+//          the syndrome of an error pattern is the xor of the syndromes of its bits, and the error
+//          ... pattern is undetectable exactly when its syndrome is zero, i.e. when G divides it
+// @params: GeneratorPolynomial generator
+//          size_t codeword_length, number of bits of the codeword
+// @return: std::vector<uint32_t>, syndrome of the bit d bits before the end at index d
+// @author: Donghan Xia, 2026/10/17
+std::vector<uint32_t> BuildBitSyndromes(const GeneratorPolynomial &generator, size_t codeword_length) {
+    std::vector<uint32_t> bit_syndromes(codeword_length);
+    uint64_t syndrome = 1;
+
+    for (size_t end_distance = 0; end_distance < codeword_length; end_distance++) {
+        bit_syndromes[end_distance] = syndrome;
+        // multiply by x and reduce modulo the generator
+        syndrome <<= 1;
+        if ((syndrome >> generator.degree) & 1) {
+            syndrome ^= generator.poly_value;
+        }
+    }
+
+    return bit_syndromes;
+}
+
+// @brief:  count the undetectable error patterns of error_weight bits whose highest bit is leading_bit
+//          the other error_weight - 1 bits are enumerated in the revolving-door Gray code order
+//          ... (Knuth, TAOCP 7.2.1.3, Algorithm R), where the next pattern moves one or two bits
+//          ... of the previous one, so the syndrome is updated with at most four xors per pattern
+// @params: std::vector<uint32_t> bit_syndromes
+//          size_t leading_bit, at least error_weight - 1
+//          int error_weight, at least 1
+// @return: uint64_t
+// @author: Donghan Xia, 2026/10/17
+uint64_t CountUndetectableWithLeadingBit(const std::vector<uint32_t> &bit_syndromes, size_t leading_bit, int error_weight) {
+    const uint32_t *syndromes = bit_syndromes.data();
+    int tail_weight = error_weight - 1;
+    if (tail_weight == 0) {
+        return syndromes[leading_bit] == 0;
+    }
+
+    // positions[1] < ... < positions[tail_weight] of the bits below the leading bit, with
+    // ... positions[tail_weight + 1] as the sentinel
+    std::vector<size_t> positions(tail_weight + 2);
+    uint32_t syndrome = syndromes[leading_bit];
+    for (int index = 1; index <= tail_weight; index++) {
+        positions[index] = index - 1;
+        syndrome ^= syndromes[index - 1];
+    }
+    positions[tail_weight + 1] = leading_bit;
+    size_t *c = positions.data();
+
+    uint64_t undetectable_count = 0;
+    while (true) {
+        undetectable_count += syndrome == 0;
+
+        // easy case: move the lowest bit by one
+        int index = 2;
+        bool is_increasing;
+        if (tail_weight % 2 == 1) {
+            if (c[1] + 1 < c[2]) {
+                syndrome ^= syndromes[c[1]] ^ syndromes[c[1] + 1];
+                c[1]++;
+                continue;
+            }
+            is_increasing = false;
+        } else {
+            if (c[1] > 0) {
+                syndrome ^= syndromes[c[1]] ^ syndromes[c[1] - 1];
+                c[1]--;
+                continue;
+            }
+            is_increasing = true;
+        }
+
+        // move a higher bit and the bit below it
+        bool is_moved = false;
+        while (index <= tail_weight) {
+            if (!is_increasing) {
+                // c[index] == c[index - 1] + 1: try to decrease c[index]
+                if (c[index] >= (size_t) index) {
+                    // c[index - 1] stays in the pattern, only at the next index
+                    syndrome ^= syndromes[c[index]] ^ syndromes[index - 2];
+                    c[index] = c[index - 1];
+                    c[index - 1] = index - 2;
+                    is_moved = true;
+                    break;
+                }
+                index++;
+                is_increasing = true;
+            } else {
+                // c[index - 1] == index - 2: try to increase c[index]
+                if (c[index] + 1 < c[index + 1]) {
+                    // c[index] stays in the pattern, only at the previous index
+                    syndrome ^= syndromes[c[index - 1]] ^ syndromes[c[index] + 1];
+                    c[index - 1] = c[index];
+                    c[index]++;
+                    is_moved = true;
+                    break;
+                }
+                index++;
+                is_increasing = false;
+            }
+        }
+        if (!is_moved) {
+            break;
+        }
+    }
+
+    return undetectable_count;
+}
+
+// @brief:  count the undetectable error patterns of every weight up to max_weight
+//          the patterns of each weight are split by their highest bit into one task per bit
+//          ... position, the longest tasks (highest bits) first
+// @params: std::vector<uint32_t> bit_syndromes
+//          int max_weight
+//          WorkStealingPool &pool
+// @return: std::vector<uint64_t>, number of undetectable patterns at index weight
+// @author: Donghan Xia, 2026/10/17
+std::vector<uint64_t> CountUndetectablePatterns(const std::vector<uint32_t> &bit_syndromes, int max_weight, WorkStealingPool &pool) {
+    size_t codeword_length = bit_syndromes.size();
+    std::vector<uint64_t> task_counts(codeword_length * max_weight, 0);
+
+    pool.ParallelFor(task_counts.size(), [&](size_t task_index) {
+        int error_weight = 1 + task_index / codeword_length;
+        size_t leading_bit = codeword_length - 1 - task_index % codeword_length;
+        if (leading_bit + 1 >= (size_t) error_weight) {
+            task_counts[task_index] = CountUndetectableWithLeadingBit(bit_syndromes, leading_bit, error_weight);
+        }
+    });
+
+    std::vector<uint64_t> weight_counts(max_weight + 1, 0);
+    for (size_t task_index = 0; task_index < task_counts.size(); task_index++) {
+        weight_counts[1 + task_index / codeword_length] += task_counts[task_index];
+    }
+    return weight_counts;
+}
+
+// @brief:  count the undetectable error patterns of one weight on a single thread, meeting in the
+//          ... middle for the low weights instead of enumerating every pattern:
+//          ... weight 2: two bits with the same syndrome, found by sorting the syndromes
+//          ... weight 3: every pair of bits looks up the third bit with the xor of their syndromes
+//          ... weight 4: two disjoint pairs with the same pair syndrome, found by sorting the pair
+//          ... syndromes; without weight 2 patterns two pairs sharing a bit never have the same
+//          ... syndrome, and every pattern is counted once for each of its 3 splits into pairs
+//          ... higher weights use the Gray code enumeration of CountUndetectableWithLeadingBit()
+// @params: std::vector<uint32_t> bit_syndromes
+//          int error_weight
+// @return: uint64_t
+// @author: Donghan Xia, 2026/10/17
+uint64_t CountUndetectableOfWeight(const std::vector<uint32_t> &bit_syndromes, int error_weight) {
+    size_t codeword_length = bit_syndromes.size();
+    uint64_t undetectable_count = 0;
+
+    if (error_weight == 1) {
+        return std::count(bit_syndromes.begin(), bit_syndromes.end(), 0u);
+    }
+
+    if (error_weight == 2) {
+        std::vector<uint32_t> sorted_syndromes = bit_syndromes;
+        std::sort(sorted_syndromes.begin(), sorted_syndromes.end());
+        for (size_t start = 0, end = 0; start < codeword_length; start = end) {
+            while (end < codeword_length && sorted_syndromes[end] == sorted_syndromes[start]) {
+                end++;
+            }
+            undetectable_count += (uint64_t) (end - start) * (end - start - 1) / 2;
+        }
+        return undetectable_count;
+    }
+
+    if (error_weight == 3) {
+        // (syndrome, bit) sorted, so the bits of one syndrome above a given bit are a sorted range
+        std::vector<std::pair<uint32_t, size_t>> syndrome_bits(codeword_length);
+        for (size_t bit_index = 0; bit_index < codeword_length; bit_index++) {
+            syndrome_bits[bit_index] = {bit_syndromes[bit_index], bit_index};
+        }
+        std::sort(syndrome_bits.begin(), syndrome_bits.end());
+
+        for (size_t first_bit = 0; first_bit < codeword_length; first_bit++) {
+            for (size_t second_bit = first_bit + 1; second_bit < codeword_length; second_bit++) {
+                uint32_t third_syndrome = bit_syndromes[first_bit] ^ bit_syndromes[second_bit];
+                auto range_begin = std::lower_bound(syndrome_bits.begin(), syndrome_bits.end(),
+                        std::make_pair(third_syndrome, second_bit + 1));
+                auto range_end = std::lower_bound(range_begin, syndrome_bits.end(),
+                        std::make_pair(third_syndrome + 1, (size_t) 0));
+                if (third_syndrome == UINT32_MAX) {
+                    range_end = syndrome_bits.end();
+                }
+                undetectable_count += range_end - range_begin;
+            }
+        }
+        return undetectable_count;
+    }
+
+    if (error_weight == 4 && CountUndetectableOfWeight(bit_syndromes, 2) == 0) {
+        std::vector<uint32_t> pair_syndromes;
+        pair_syndromes.reserve(codeword_length * (codeword_length - 1) / 2);
+        for (size_t first_bit = 0; first_bit < codeword_length; first_bit++) {
+            for (size_t second_bit = first_bit + 1; second_bit < codeword_length; second_bit++) {
+                pair_syndromes.push_back(bit_syndromes[first_bit] ^ bit_syndromes[second_bit]);
+            }
+        }
+        std::sort(pair_syndromes.begin(), pair_syndromes.end());
+
+        for (size_t start = 0, end = 0; start < pair_syndromes.size(); start = end) {
+            while (end < pair_syndromes.size() && pair_syndromes[end] == pair_syndromes[start]) {
+                end++;
+            }
+            undetectable_count += (uint64_t) (end - start) * (end - start - 1) / 2;
+        }
+        return undetectable_count / 3;
+    }
+
+    for (size_t leading_bit = error_weight - 1; leading_bit < codeword_length; leading_bit++) {
+        undetectable_count += CountUndetectableWithLeadingBit(bit_syndromes, leading_bit, error_weight);
+    }
+    return undetectable_count;
+}
@@ -0,0 +1,32 @@
+#ifndef CRC_WEIGHTS_H
+#define CRC_WEIGHTS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "thread_pool.h"
+
+// generator polynomial of the weight analysis, e.g. 1100000001111 for CRC-12
+struct GeneratorPolynomial {
+    // every coefficient including the highest one, the coefficient of x^0 is the lowest bit
+    uint64_t poly_value;
+    int degree;
+};
+
+bool ParseGeneratorPolynomial(const std::string &generator_data, GeneratorPolynomial &generator);
+
+bool FindAlgorithmGenerator(const std::string &algorithm_name, GeneratorPolynomial &generator);
+
+std::string FormatGeneratorPolynomial(const GeneratorPolynomial &generator);
+
+std::vector<uint32_t> BuildBitSyndromes(const GeneratorPolynomial &generator, size_t codeword_length);
+
+uint64_t CountUndetectableWithLeadingBit(const std::vector<uint32_t> &bit_syndromes, size_t leading_bit, int error_weight);
+
+std::vector<uint64_t> CountUndetectablePatterns(const std::vector<uint32_t> &bit_syndromes, int max_weight, WorkStealingPool &pool);
+
+uint64_t CountUndetectableOfWeight(const std::vector<uint32_t> &bit_syndromes, int error_weight);
+
+#endif
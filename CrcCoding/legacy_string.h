@@ -0,0 +1,39 @@
+#ifndef LEGACY_STRING_H
+#define LEGACY_STRING_H
+
+#include <string>
+#include <utility>
+
+// the original '0'/'1' string implementations of crc_tx, crc_rx and crc_vs_checksum, kept only as
+// ... the baseline of crc_bench, so every packed kernel is measured against the code it replaced
+// the functions are unchanged except that nothing is printed, the bench measures the computation
+// they are in their own namespace since some names are still used by the packed implementations
+namespace legacy {
+
+std::pair<std::string, std::string> SplitComboData(std::string combo_data);
+
+void ComplementZeros(std::string &source_data, int diff);
+
+void FindNextDivDigit(int &div_index, std::string source_data);
+
+char XorSingleBit(char first_bit, char second_bit);
+
+void IntroduceErrorBits(std::string &encoded_code, std::string error_bit_data);
+
+std::string EncodeChecksum(std::string source_data);
+
+std::string GetBinaryChecksum(int decimal_sum, int data_size);
+
+std::string ConvertDecimalToBinary(int decimal_data, int data_size);
+
+int ConvertBinaryToDecimal(std::string binary_data);
+
+bool CheckCrc(std::string received_data, std::string generator_data);
+
+bool CheckRemainder(std::string result_data);
+
+std::string EncodeCrc(std::string source_data, std::string generator_data);
+
+}
+
+#endif
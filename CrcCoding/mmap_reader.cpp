@@ -0,0 +1,148 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "mmap_reader.h"
+
+// @brief:  map the whole file read-only and tell the kernel it is read from front to back, so it
+//          ... reads ahead aggressively
+// @params: std::string file_name
+// @return: void
+// @author: Donghan Xia, 2026/10/17
+MmapReader::MmapReader(const std::string &file_name)
+        : file_descriptor_(-1), mapped_data_(nullptr), mapped_size_(0), released_end_(nullptr) {
+    file_descriptor_ = open(file_name.c_str(), O_RDONLY);
+    if (file_descriptor_ < 0) {
+        return;
+    }
+
+    struct stat file_status;
+    if (fstat(file_descriptor_, &file_status) != 0 || file_status.st_size == 0) {
+        return;
+    }
+
+    void *mapped_address = mmap(nullptr, file_status.st_size, PROT_READ, MAP_PRIVATE, file_descriptor_, 0);
+    if (mapped_address == MAP_FAILED) {
+        return;
+    }
+    madvise(mapped_address, file_status.st_size, MADV_SEQUENTIAL);
+
+    mapped_data_ = (const char *) mapped_address;
+    mapped_size_ = file_status.st_size;
+    remaining_data_ = std::string_view(mapped_data_, mapped_size_);
+    released_end_ = mapped_data_;
+}
+
+// @brief:  take over the mapping of another reader, which is left without any file
+// @params: MmapReader &&other
+// @return: void
+// @author: Donghan Xia, 2026/10/17
+MmapReader::MmapReader(MmapReader &&other)
+        : file_descriptor_(other.file_descriptor_), mapped_data_(other.mapped_data_),
+          mapped_size_(other.mapped_size_), remaining_data_(other.remaining_data_),
+          released_end_(other.released_end_) {
+    other.file_descriptor_ = -1;
+    other.mapped_data_ = nullptr;
+    other.mapped_size_ = 0;
+    other.remaining_data_ = std::string_view();
+    other.released_end_ = nullptr;
+}
+
+// @brief:  unmap the file and close it, every line view becomes invalid
+// @params: void
+// @return: void
+// @author: Donghan Xia, 2026/10/17
+MmapReader::~MmapReader() {
+    if (mapped_data_ != nullptr) {
+        munmap((void *) mapped_data_, mapped_size_);
+    }
+    if (file_descriptor_ >= 0) {
+        close(file_descriptor_);
+    }
+}
+
+// @brief:  check whether the file could be opened
+// @params: void
+// @return: bool
+// @author: Donghan Xia, 2026/10/17
+bool MmapReader::IsOpen() const {
+    return file_descriptor_ >= 0;
+}
+
+// @brief:  get the whole content of the file
+// @params: void
+// @return: std::string_view
+// @author: Donghan Xia, 2026/10/17
+std::string_view MmapReader::GetData() const {
+    return std::string_view(mapped_data_, mapped_size_);
+}
+
+// @brief:  get the next line without its end-line, same lines as the ifstream::peek() and
+//          ... std::getline() loop: a last line without end-line is a line, nothing after the
+//          ... last end-line is not
+// @params: std::string_view &line_data, the pass by reference params to store the line
+// @return: bool, false if there is no line left
+// @author: Donghan Xia, 2026/10/17
+bool MmapReader::NextLine(std::string_view &line_data) {
+    if (!SplitNextLine(remaining_data_, line_data)) {
+        return false;
+    }
+
+    ReleaseBefore(line_data.data());
+    return true;
+}
+
+// @brief:  hand the whole pages before position back to the kernel once at least MMAP_RELEASE_SIZE
+//          ... bytes are read since the last time, they are read from the file again only if they
+//          ... are touched again
+// @params: const char *position, a position inside the mapping
+// @return: void
+// @author: Donghan Xia, 2026/10/17
+void MmapReader::ReleaseBefore(const char *position) {
+    if ((size_t) (position - released_end_) < MMAP_RELEASE_SIZE) {
+        return;
+    }
+
+    size_t page_size = sysconf(_SC_PAGESIZE);
+    // mmap() returns a page aligned address, so page boundaries are offsets that are page multiples
+    size_t release_size = (position - mapped_data_) / page_size * page_size;
+    if (mapped_data_ + release_size <= released_end_) {
+        return;
+    }
+
+    madvise((void *) mapped_data_, release_size, MADV_DONTNEED);
+    released_end_ = mapped_data_ + release_size;
+}
+
+// @brief:  split the first line off a piece of text, a trailing '\r' of the line is dropped to
+//          ... tolerate the Windows line ending
+// @params: std::string_view &remaining_data, the pass by reference params of the text, the line
+//          ... and its end-line are removed from it
+//          std::string_view &line_data, the pass by reference params to store the line
+// @return: bool, false if the text is empty
+// @author: Donghan Xia, 2026/10/17
+bool SplitNextLine(std::string_view &remaining_data, std::string_view &line_data) {
+    if (remaining_data.empty()) {
+        return false;
+    }
+
+    size_t line_end = remaining_data.find('\n');
+    if (line_end == std::string_view::npos) {
+        line_data = remaining_data;
+        remaining_data = std::string_view();
+    } else {
+        line_data = remaining_data.substr(0, line_end);
+        remaining_data.remove_prefix(line_end + 1);
+    }
+
+    if (!line_data.empty() && line_data.back() == '\r') {
+        line_data.remove_suffix(1);
+    }
+    return true;
+}
@@ -0,0 +1,48 @@
+#ifndef MMAP_READER_H
+#define MMAP_READER_H
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+// number of bytes behind the current line after which the pages already read are handed back to
+// ... the kernel, so that a file larger than the memory can be read
+#define MMAP_RELEASE_SIZE ((size_t) 64 << 20)
+
+// zero-copy line reader that maps a whole file into memory
+// every line is a std::string_view into the mapping, so reading a line allocates and copies nothing,
+// ... the views stay valid as long as the reader lives
+// a missing or empty file reads as a file without any line
+class MmapReader {
+public:
+    explicit MmapReader(const std::string &file_name);
+
+    ~MmapReader();
+
+    MmapReader(const MmapReader &) = delete;
+
+    MmapReader &operator=(const MmapReader &) = delete;
+
+    MmapReader(MmapReader &&other);
+
+    bool IsOpen() const;
+
+    std::string_view GetData() const;
+
+    bool NextLine(std::string_view &line_data);
+
+    void ReleaseBefore(const char *position);
+
+private:
+    int file_descriptor_;
+    const char *mapped_data_;
+    size_t mapped_size_;
+    // the part of the file after the last line returned
+    std::string_view remaining_data_;
+    // the pages before this position are handed back to the kernel already
+    const char *released_end_;
+};
+
+bool SplitNextLine(std::string_view &remaining_data, std::string_view &line_data);
+
+#endif
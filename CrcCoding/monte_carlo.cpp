@@ -0,0 +1,206 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+#include "monte_carlo.h"
+
+// @brief:  next value of the splitmix64 generator, used to spread a seed over the xoshiro state
+// @params: uint64_t &state
+// @return: uint64_t
+// @author: Donghan Xia, 2026/10/17
+static uint64_t NextSplitMix64(uint64_t &state) {
+    uint64_t value = (state += 0x9e3779b97f4a7c15);
+    value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9;
+    value = (value ^ (value >> 27)) * 0x94d049bb133111eb;
+    return value ^ (value >> 31);
+}
+
+// @brief:  seed the generator, the splitmix64 output is never all zeros for all four words
+// @params: uint64_t seed
+// @author: Donghan Xia, 2026/10/17
+Xoshiro256::Xoshiro256(uint64_t seed) {
+    for (uint64_t &state_word : state_) {
+        state_word = NextSplitMix64(seed);
+    }
+}
+
+// @brief:  parse a channel model: "ber:<probability>", "weight:<bits>" or "burst:<bits>"
+// @params: std::string model_name
+//          ErrorModel &error_model, the pass by reference params to store the result
+// @return: bool, false if the model is unknown or its value is out of range
+// @author: Donghan Xia, 2026/10/17
+bool ParseErrorModel(const std::string &model_name, ErrorModel &error_model) {
+    size_t split_position = model_name.find(':');
+    if (split_position == model_name.npos) {
+        return false;
+    }
+    std::string kind_name = model_name.substr(0, split_position);
+    const char *value_data = model_name.c_str() + split_position + 1;
+    char *value_end = nullptr;
+
+    if (kind_name == "ber") {
+        error_model.kind = ErrorModel::BERNOULLI;
+        error_model.bit_error_rate = strtod(value_data, &value_end);
+        return *value_data != '\0' && *value_end == '\0'
+                && error_model.bit_error_rate > 0 && error_model.bit_error_rate < 1;
+    }
+
+    long long value = strtoll(value_data, &value_end, 10);
+    if (*value_data == '\0' || *value_end != '\0' || value < 1) {
+        return false;
+    }
+    if (kind_name == "weight") {
+        error_model.kind = ErrorModel::FIXED_WEIGHT;
+        error_model.error_weight = value;
+    } else if (kind_name == "burst") {
+        error_model.kind = ErrorModel::BURST;
+        error_model.burst_length = value;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+// @brief:  fill packed data with random bits
+// @params: Xoshiro256 &generator
+//          size_t bit_count
+//          PackedBits &packed_data, the pass by reference params to store the result
+// @return: void
+// @author: Donghan Xia, 2026/10/17
+void FillRandomBits(Xoshiro256 &generator, size_t bit_count, PackedBits &packed_data) {
+    packed_data.words.resize((bit_count + 63) / 64);
+    for (uint64_t &word : packed_data.words) {
+        word = generator.Next();
+    }
+    // clear the unused bits after bit_count
+    ResizeBits(packed_data, bit_count);
+}
+
+// @brief:  flip one bit of packed data
+// @params: uint8_t *bytes
+//          size_t bit_index
+// @return: void
+// @author: Donghan Xia, 2026/10/17
+static inline void FlipBit(uint8_t *bytes, size_t bit_index) {
+    bytes[bit_index / 8] ^= 0x80 >> (bit_index % 8);
+}
+
+// @brief:  generate the error bits of one trial
+//          the Bernoulli model jumps from one error bit to the next with geometric gaps, so a low
+//          ... bit error rate costs one random number per error bit instead of one per bit
+// @params: Xoshiro256 &generator
+//          ErrorModel error_model
+//          size_t bit_count, number of bits of the codeword
+//          PackedBits &error_bit_data, the pass by reference params to store the result
+// @return: size_t, number of flipped bits
+// @author: Donghan Xia, 2026/10/17
+size_t GenerateErrorBits(Xoshiro256 &generator, const ErrorModel &error_model, size_t bit_count, PackedBits &error_bit_data) {
+    error_bit_data.bit_count = bit_count;
+    error_bit_data.words.assign((bit_count + 63) / 64, 0);
+    uint8_t *bytes = error_bit_data.Bytes();
+    size_t error_count = 0;
+
+    if (error_model.kind == ErrorModel::BERNOULLI) {
+        double log_keep_rate = std::log1p(-error_model.bit_error_rate);
+        // the gap before the next error bit is floor(log(u) / log(1 - p)), u uniform in (0, 1]
+        double bit_index = std::floor(std::log(generator.NextUnit()) / log_keep_rate);
+        while (bit_index < (double) bit_count) {
+            FlipBit(bytes, (size_t) bit_index);
+            error_count++;
+            bit_index += 1 + std::floor(std::log(generator.NextUnit()) / log_keep_rate);
+        }
+    } else if (error_model.kind == ErrorModel::FIXED_WEIGHT) {
+        size_t error_weight = std::min(error_model.error_weight, bit_count);
+        // draw positions until error_weight distinct bits are flipped
+        while (error_count < error_weight) {
+            size_t bit_index = generator.NextBelow(bit_count);
+            if ((bytes[bit_index / 8] & (0x80 >> (bit_index % 8))) == 0) {
+                FlipBit(bytes, bit_index);
+                error_count++;
+            }
+        }
+    } else if (bit_count > 0) {
+        size_t burst_length = std::min(error_model.burst_length, bit_count);
+        size_t start_bit = generator.NextBelow(bit_count - burst_length + 1);
+        size_t end_bit = start_bit + burst_length - 1;
+
+        FlipBit(bytes, start_bit);
+        error_count++;
+        uint64_t random_bits = 0;
+        for (size_t bit_index = start_bit + 1; bit_index < end_bit; bit_index++) {
+            if ((bit_index - start_bit - 1) % 64 == 0) {
+                random_bits = generator.Next();
+            }
+            if (random_bits & 1) {
+                FlipBit(bytes, bit_index);
+                error_count++;
+            }
+            random_bits >>= 1;
+        }
+        if (end_bit != start_bit) {
+            FlipBit(bytes, end_bit);
+            error_count++;
+        }
+    }
+
+    return error_count;
+}
+
+// @brief:  seed of one task, so the counts only depend on the seed and not on which thread runs
+//          ... which task
+// @params: uint64_t seed
+//          uint64_t task_index
+// @return: uint64_t
+// @author: Donghan Xia, 2026/10/17
+uint64_t GetTaskSeed(uint64_t seed, uint64_t task_index) {
+    uint64_t state = seed ^ (task_index * 0xd1b54a32d192ed03);
+    return NextSplitMix64(state);
+}
+
+// @brief:  Wilson score interval of a binomial proportion, which stays meaningful when there are
+//          ... few or no successes, e.g. the undetected errors of a strong code
+// @params: uint64_t success_count
+//          uint64_t trial_count
+//          double &lower_bound, the pass by reference params to store the result
+//          double &upper_bound
+// @return: void
+// @author: Donghan Xia, 2026/10/17
+void GetWilsonInterval(uint64_t success_count, uint64_t trial_count, double &lower_bound, double &upper_bound) {
+    if (trial_count == 0) {
+        lower_bound = 0;
+        upper_bound = 1;
+        return;
+    }
+
+    double trials = (double) trial_count;
+    double rate = success_count / trials;
+    double z_square = CONFIDENCE_Z_VALUE * CONFIDENCE_Z_VALUE;
+    double center = (rate + z_square / (2 * trials)) / (1 + z_square / trials);
+    double half_width = CONFIDENCE_Z_VALUE / (1 + z_square / trials)
+            * std::sqrt(rate * (1 - rate) / trials + z_square / (4 * trials * trials));
+
+    lower_bound = std::max(0.0, center - half_width);
+    upper_bound = std::min(1.0, center + half_width);
+}
+
+// @brief:  print one row of the Monte Carlo table: the trials with errors, the undetected ones and
+//          ... the undetected rate among the trials with errors with its 95% confidence interval
+// @params: std::string code_name
+//          DetectionCounts counts
+// @return: void
+// @author: Donghan Xia, 2026/10/17
+void PrintDetectionCounts(const std::string &code_name, const DetectionCounts &counts) {
+    double lower_bound = 0;
+    double upper_bound = 0;
+    GetWilsonInterval(counts.undetected_count, counts.error_count, lower_bound, upper_bound);
+    double rate = counts.error_count > 0 ? (double) counts.undetected_count / counts.error_count : 0;
+
+    char row_data[160];
+    snprintf(row_data, sizeof(row_data), "%-10s %16llu %16llu  %.3e  [%.3e, %.3e]",
+            code_name.c_str(), (unsigned long long) counts.error_count,
+            (unsigned long long) counts.undetected_count, rate, lower_bound, upper_bound);
+    std::cout << row_data << std::endl;
+}
@@ -0,0 +1,105 @@
+#ifndef MONTE_CARLO_H
+#define MONTE_CARLO_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "bit_packing.h"
+
+// number of trials of one task of the Monte Carlo mode, every task has its own random generator
+#define MONTE_CARLO_TASK_TRIALS ((uint64_t) 1 << 16)
+// default number of message bits of every trial
+#define DEFAULT_MONTE_CARLO_LENGTH 1024
+// default channel model of the Monte Carlo mode
+#define DEFAULT_ERROR_MODEL "ber:0.001"
+// default seed, the same seed gives the same counts with any number of threads
+#define DEFAULT_MONTE_CARLO_SEED 1
+// z value of the 95% confidence intervals
+#define CONFIDENCE_Z_VALUE 1.959963984540054
+
+// xoshiro256** random generator of Blackman and Vigna, seeded with splitmix64
+class Xoshiro256 {
+public:
+    explicit Xoshiro256(uint64_t seed);
+
+    uint64_t Next() {
+        uint64_t result = RotateLeft(state_[1] * 5, 7) * 9;
+        uint64_t shifted = state_[1] << 17;
+
+        state_[2] ^= state_[0];
+        state_[3] ^= state_[1];
+        state_[1] ^= state_[2];
+        state_[0] ^= state_[3];
+        state_[2] ^= shifted;
+        state_[3] = RotateLeft(state_[3], 45);
+
+        return result;
+    }
+
+    // uniform in [0, bound) by Lemire's multiply-shift, the bias is below 2^-40 for any bound used here
+    uint64_t NextBelow(uint64_t bound) {
+        return (uint64_t) (((unsigned __int128) Next() * bound) >> 64);
+    }
+
+    // uniform in (0, 1]
+    double NextUnit() {
+        return ((Next() >> 11) + 1) * 0x1.0p-53;
+    }
+
+private:
+    static uint64_t RotateLeft(uint64_t value, int shift) {
+        return (value << shift) | (value >> (64 - shift));
+    }
+
+    uint64_t state_[4];
+};
+
+// channel model that generates the error bits of a trial
+struct ErrorModel {
+    enum Kind {
+        // every bit is flipped independently with probability bit_error_rate
+        BERNOULLI,
+        // exactly error_weight distinct bits are flipped
+        FIXED_WEIGHT,
+        // a burst of burst_length bits: its first and last bits are flipped, the bits between are random
+        BURST,
+    };
+
+    Kind kind = BERNOULLI;
+    double bit_error_rate = 0;
+    size_t error_weight = 0;
+    size_t burst_length = 0;
+};
+
+// what the receiver makes of one codeword sent through the channel model
+enum ChannelOutcome {
+    // no bit was flipped
+    CHANNEL_INTACT,
+    // bits were flipped and the code rejected the codeword
+    CHANNEL_DETECTED,
+    // bits were flipped but the code accepted the codeword
+    CHANNEL_UNDETECTED,
+};
+
+// counts of one code over a number of trials
+struct DetectionCounts {
+    // trials whose error bits are not all zero
+    uint64_t error_count = 0;
+    // trials with errors that the code accepted
+    uint64_t undetected_count = 0;
+};
+
+bool ParseErrorModel(const std::string &model_name, ErrorModel &error_model);
+
+void FillRandomBits(Xoshiro256 &generator, size_t bit_count, PackedBits &packed_data);
+
+size_t GenerateErrorBits(Xoshiro256 &generator, const ErrorModel &error_model, size_t bit_count, PackedBits &error_bit_data);
+
+uint64_t GetTaskSeed(uint64_t seed, uint64_t task_index);
+
+void GetWilsonInterval(uint64_t success_count, uint64_t trial_count, double &lower_bound, double &upper_bound);
+
+void PrintDetectionCounts(const std::string &code_name, const DetectionCounts &counts);
+
+#endif
@@ -0,0 +1,29 @@
+#include <string_view>
+#include <utility>
+
+#include "pipeline.h"
+
+// @brief:  split combo data into source data and error bit data
+//          both sections are views into the combo data, nothing is copied
+// @params: std::string_view combo_data, the original data from each row of dataVs.txt file that contains
+//          ... both source data and error bit data
+// @return: std::pair<std::string_view, std::string_view>, pair object with two component views
+//          ... to the source data and the error bit data
+// @author: Donghan Xia, 2021/09/23
+std::pair<std::string_view, std::string_view> SplitComboData(std::string_view combo_data) {
+    std::pair<std::string_view, std::string_view> data_pair;
+
+    // find the position of char ' ' in combo data
+    size_t split_position = combo_data.find(0x20);
+
+    if (split_position != combo_data.npos) {
+        // implement split action according to the position of char ' '
+        data_pair.first = combo_data.substr(0, split_position);
+        data_pair.second = combo_data.substr(split_position + 1);
+    }
+
+    // std::cout << data_pair.first << std::endl;
+    // std::cout << data_pair.second << std::endl;
+
+    return data_pair;
+}
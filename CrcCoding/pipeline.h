@@ -0,0 +1,352 @@
+#ifndef PIPELINE_H
+#define PIPELINE_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "bit_packing.h"
+#include "mmap_reader.h"
+#include "record_reader.h"
+#include "stage_profiler.h"
+
+// one record flowing through the stages of a pipeline
+// the same object is reused for every record, so the packed buffers keep their capacity and
+// ... a record does not allocate once the buffers are large enough
+struct PipelineRecord {
+    // where the record comes from, used in the messages of skipped records
+    std::string_view file_name;
+    int line_number = 0;
+    // the raw line, or the raw bytes of a binary record, a view into the input
+    std::string_view line_data;
+    // the mapped file the line belongs to, nullptr if the input is not a mapped file
+    MmapReader *file_reader = nullptr;
+    // packed source data and error bit data
+    PackedBits source_data;
+    PackedBits error_bit_data;
+    // check value (CRC or checksum) of the last encoder stage and its number of bits
+    uint32_t check_value = 0;
+    int check_width = 0;
+    // source data followed by the check value, the errors are introduced into it
+    PackedBits encoded_data;
+    // result of the last checker stage
+    bool is_accepted = false;
+    // CRC of the data section xored with the CRC section of the last checker stage, zero if accepted
+    uint32_t syndrome = 0;
+    // bits of the line flipped by the correction stage, from the beginning of the line
+    std::vector<size_t> corrected_bits;
+};
+
+// base of all stages
+// a stage provides bool Process(PipelineRecord &record), which returns false to drop the record
+// ... before the later stages, and may hide Finish() to run once after the last record
+// a stage also names the ProfileStage its time is counted in as kProfileStage
+// there is no virtual function: every call is resolved at compile time and can be inlined, which is
+// ... why the generic stages below are defined in this header
+struct PipelineStage {
+    void Finish() {}
+};
+
+// pipeline composed at compile time: a source that yields records, followed by the stages every
+// ... record goes through in order, e.g.
+// ...     Pipeline<MmapLineSource, CrcStreamCheck<Crc12>, CrcCorrect<Crc12>, PrintCheckResult>
+// a source provides bool Next(PipelineRecord &record), which returns false after the last record,
+// ... and kBitsPerChar, the number of data bits in a character of its records
+template <typename Source, typename... Stages>
+class Pipeline {
+public:
+    Pipeline() = default;
+
+    explicit Pipeline(Source source, Stages... stages)
+            : source_(std::move(source)), stages_(std::move(stages)...) {}
+
+    // @brief:  run every record of the source through the stages, then finish the stages
+    // @params: void
+    // @return: void
+    // @author: Donghan Xia, 2026/10/17
+    void Run() {
+        if (IsStageProfilingEnabled()) {
+            RunProfiled();
+            return;
+        }
+
+        PipelineRecord record;
+        while (source_.Next(record)) {
+            // the && fold stops at the first stage that drops the record
+            std::apply([&record](auto &... stage) {
+                (stage.Process(record) && ...);
+            }, stages_);
+        }
+
+        std::apply([](auto &... stage) {
+            (stage.Finish(), ...);
+        }, stages_);
+    }
+
+private:
+    // @brief:  Run() with the ticks of the source and of every stage counted, see stage_profiler.h
+    //          the counters are kept by this run and merged once at the end, so the pipelines of
+    //          ... separate threads do not share any counter while they run
+    // @params: void
+    // @return: void
+    // @author: Donghan Xia, 2026/10/17
+    void RunProfiled() {
+        PipelineRecord record;
+        StageCounters counters;
+        uint64_t record_start = ReadProfileTicks();
+
+        while (source_.Next(record)) {
+            uint64_t stage_start = ReadProfileTicks();
+            counters.stage_ticks[PROFILE_READ] += stage_start - record_start;
+            counters.record_count++;
+            counters.bit_count += record.line_data.size() * Source::kBitsPerChar;
+
+            std::apply([&](auto &... stage) {
+                (ProcessProfiled(stage, record, counters, stage_start) && ...);
+            }, stages_);
+
+            CountRecordLatency(counters, stage_start - record_start);
+            record_start = stage_start;
+        }
+
+        std::apply([&](auto &... stage) {
+            (FinishProfiled(stage, counters), ...);
+        }, stages_);
+        MergeStageCounters(counters);
+    }
+
+    // @brief:  process a record by one stage and count the ticks since the previous stage
+    // @params: Stage &stage
+    //          PipelineRecord &record
+    //          StageCounters &counters
+    //          uint64_t &stage_start, the pass by reference params of the ticks when the stage starts
+    // @return: bool, the result of the stage
+    // @author: Donghan Xia, 2026/10/17
+    template <typename Stage>
+    static bool ProcessProfiled(Stage &stage, PipelineRecord &record, StageCounters &counters, uint64_t &stage_start) {
+        bool is_kept = stage.Process(record);
+        uint64_t stage_end = ReadProfileTicks();
+        counters.stage_ticks[Stage::kProfileStage] += stage_end - stage_start;
+        stage_start = stage_end;
+        return is_kept;
+    }
+
+    // @brief:  finish one stage and count its ticks, e.g. a sink that writes out its buffer
+    // @params: Stage &stage
+    //          StageCounters &counters
+    // @return: void
+    // @author: Donghan Xia, 2026/10/17
+    template <typename Stage>
+    static void FinishProfiled(Stage &stage, StageCounters &counters) {
+        uint64_t finish_start = ReadProfileTicks();
+        stage.Finish();
+        counters.stage_ticks[Stage::kProfileStage] += ReadProfileTicks() - finish_start;
+    }
+
+    Source source_;
+    std::tuple<Stages...> stages_;
+};
+
+// @brief:  report a record that is not a bit string, either to stderr or to an error text that is
+//          ... printed later
+// @params: PipelineRecord record
+//          std::string *error_data, nullptr to print to stderr right away
+// @return: void
+// @author: Donghan Xia, 2026/10/17
+inline void ReportSkippedRecord(const PipelineRecord &record, std::string *error_data) {
+    if (error_data != nullptr) {
+        *error_data += std::string(record.file_name) + ":" + std::to_string(record.line_number)
+                + ": not a bit string, skipped\n";
+    } else {
+        std::cerr << record.file_name << ":" << record.line_number << ": not a bit string, skipped" << std::endl;
+    }
+}
+
+// source: every line of a memory-mapped file
+class MmapLineSource {
+public:
+    static constexpr int kBitsPerChar = 1;
+
+    explicit MmapLineSource(const std::string &file_name) : file_name_(file_name), file_reader_(file_name) {}
+
+    // @brief:  get the next line of the file, the Windows line ending is already dropped
+    // @params: PipelineRecord &record, the pass by reference params to store the line
+    // @return: bool, false if there is no line left
+    // @author: Donghan Xia, 2026/10/17
+    bool Next(PipelineRecord &record) {
+        if (!file_reader_.NextLine(record.line_data)) {
+            return false;
+        }
+        record.file_name = file_name_;
+        record.file_reader = &file_reader_;
+        record.line_number++;
+        return true;
+    }
+
+private:
+    std::string file_name_;
+    MmapReader file_reader_;
+};
+
+// source: the lines of a piece of text, e.g. a batch of lines of a larger file
+class ViewLineSource {
+public:
+    static constexpr int kBitsPerChar = 1;
+
+    // @brief:  the text covers its first line through the end of its last line, so trailing empty
+    //          ... lines leave nothing in the text and line_count tells how many lines there are
+    // @params: std::string_view text_data
+    //          int line_count
+    //          int first_line_number, line number of the first line in the whole file
+    //          std::string_view file_name
+    // @author: Donghan Xia, 2026/10/17
+    ViewLineSource(std::string_view text_data, int line_count, int first_line_number, std::string_view file_name)
+            : remaining_data_(text_data), line_count_(line_count), next_line_number_(first_line_number),
+              file_name_(file_name) {}
+
+    // @brief:  get the next line of the text
+    // @params: PipelineRecord &record, the pass by reference params to store the line
+    // @return: bool, false if there is no line left
+    // @author: Donghan Xia, 2026/10/17
+    bool Next(PipelineRecord &record) {
+        if (line_count_ == 0) {
+            return false;
+        }
+        if (!SplitNextLine(remaining_data_, record.line_data)) {
+            record.line_data = std::string_view();
+        }
+        record.file_name = file_name_;
+        record.line_number = next_line_number_++;
+        line_count_--;
+        return true;
+    }
+
+private:
+    std::string_view remaining_data_;
+    int line_count_;
+    int next_line_number_;
+    std::string_view file_name_;
+};
+
+// source: the raw binary records or frames of a file or stdin, see RecordReader
+class BinaryRecordSource {
+public:
+    static constexpr int kBitsPerChar = 8;
+
+    // @params: std::string file_name, "-" for stdin
+    //          size_t record_size, number of bytes per record, 0 for the whole input as one record
+    //          bool is_framed, whether the input is made of length-prefixed frames
+    // @author: Donghan Xia, 2026/10/17
+    BinaryRecordSource(const std::string &file_name, size_t record_size, bool is_framed = false)
+            : file_name_(file_name), record_reader_(file_name, record_size, is_framed) {}
+
+    // @brief:  get the next record, line_number counts the records
+    // @params: PipelineRecord &record, the pass by reference params to store the record
+    // @return: bool, false if there is no record left
+    // @author: Donghan Xia, 2026/10/17
+    bool Next(PipelineRecord &record) {
+        if (!record_reader_.NextRecord(record.line_data)) {
+            return false;
+        }
+        record.file_name = file_name_;
+        record.line_number++;
+        return true;
+    }
+
+private:
+    std::string file_name_;
+    RecordReader record_reader_;
+};
+
+// stage: pack the line into the source data, lines with any character other than '0' and '1' are dropped
+class ParseBits : public PipelineStage {
+public:
+    static constexpr ProfileStage kProfileStage = PROFILE_PARSE;
+
+    explicit ParseBits(std::string *error_data = nullptr) : error_data_(error_data) {}
+
+    bool Process(PipelineRecord &record) {
+        if (!ParseBitString(record.line_data.data(), record.line_data.size(), record.source_data)) {
+            ReportSkippedRecord(record, error_data_);
+            return false;
+        }
+        return true;
+    }
+
+private:
+    // nullptr to report the dropped lines to stderr
+    std::string *error_data_;
+};
+
+std::pair<std::string_view, std::string_view> SplitComboData(std::string_view combo_data);
+
+// stage: split the line at its whitespace into source data and error bit data and pack both,
+// ... lines with any character other than '0' and '1' in either section are dropped
+class ComboSplit : public PipelineStage {
+public:
+    static constexpr ProfileStage kProfileStage = PROFILE_PARSE;
+
+    explicit ComboSplit(std::string *error_data = nullptr) : error_data_(error_data) {}
+
+    bool Process(PipelineRecord &record) {
+        std::pair<std::string_view, std::string_view> data_pair = SplitComboData(record.line_data);
+        if (!ParseBitString(data_pair.first.data(), data_pair.first.size(), record.source_data)
+                || !ParseBitString(data_pair.second.data(), data_pair.second.size(), record.error_bit_data)) {
+            ReportSkippedRecord(record, error_data_);
+            return false;
+        }
+        return true;
+    }
+
+private:
+    // nullptr to report the dropped lines to stderr
+    std::string *error_data_;
+};
+
+// stage: introduce the error bits into the encoded data, one 64-bit XOR per 64 bits
+struct InjectErrors : public PipelineStage {
+    static constexpr ProfileStage kProfileStage = PROFILE_INJECT;
+
+    bool Process(PipelineRecord &record) {
+        XorBits(record.encoded_data, record.error_bit_data);
+        return true;
+    }
+};
+
+// sink: count the records and their bytes and print the throughput to stderr after the last record,
+// ... timed from the construction of the pipeline
+class ThroughputSink : public PipelineStage {
+public:
+    static constexpr ProfileStage kProfileStage = PROFILE_OUTPUT;
+
+    bool Process(PipelineRecord &record) {
+        record_count_++;
+        byte_count_ += record.line_data.size();
+        return true;
+    }
+
+    void Finish() {
+        double elapsed_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time_).count();
+        char throughput_data[160];
+        snprintf(throughput_data, sizeof(throughput_data),
+                "records: %llu  bytes: %llu  time: %.6f s  %.3f GB/s  %.0f records/s",
+                (unsigned long long) record_count_, (unsigned long long) byte_count_, elapsed_seconds,
+                elapsed_seconds > 0 ? byte_count_ / elapsed_seconds / 1e9 : 0.0,
+                elapsed_seconds > 0 ? record_count_ / elapsed_seconds : 0.0);
+        std::cerr << throughput_data << std::endl;
+    }
+
+private:
+    std::chrono::steady_clock::time_point start_time_ = std::chrono::steady_clock::now();
+    uint64_t record_count_ = 0;
+    uint64_t byte_count_ = 0;
+};
+
+#endif
@@ -0,0 +1,228 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <unistd.h>
+
+#include "record_reader.h"
+
+// @brief:  map the file, or prepare to read stdin if file_name is "-"
+// @params: std::string file_name
+//          size_t record_size, number of bytes per record, 0 for the whole input as one record
+//          bool is_framed, whether the input is made of length-prefixed frames, record_size is
+//          ... ignored then
+// @return: void
+// @author: Donghan Xia, 2026/10/17
+RecordReader::RecordReader(const std::string &file_name, size_t record_size, bool is_framed)
+        : record_size_(record_size), is_framed_(is_framed), is_stdin_(file_name == "-"),
+        file_reader_(is_stdin_ ? "" : file_name) {
+    remaining_data_ = file_reader_.GetData();
+    if (is_stdin_) {
+        EnlargePipeBuffer(STDIN_FILENO);
+    }
+}
+
+// @brief:  check whether the input could be opened, stdin always can
+// @params: void
+// @return: bool
+// @author: Donghan Xia, 2026/10/17
+bool RecordReader::IsOpen() const {
+    return is_stdin_ || file_reader_.IsOpen();
+}
+
+// @brief:  get the next record, the pages of the mapped file before it are handed back to the kernel
+// @params: std::string_view &record_data, the pass by reference params to store the record
+// @return: bool, false if there is no record left
+// @author: Donghan Xia, 2026/10/17
+bool RecordReader::NextRecord(std::string_view &record_data) {
+    if (is_framed_) {
+        return NextFrame(record_data);
+    }
+    if (!is_stdin_) {
+        if (remaining_data_.empty()) {
+            return false;
+        }
+        size_t record_size = record_size_ == 0 ? remaining_data_.size() : std::min(record_size_, remaining_data_.size());
+        record_data = remaining_data_.substr(0, record_size);
+        remaining_data_.remove_prefix(record_size);
+
+        file_reader_.ReleaseBefore(record_data.data());
+        return true;
+    }
+
+    // the whole input as one record is read until the end of stdin
+    if (!FillBuffer(record_size_ == 0 ? SIZE_MAX : record_size_) && buffer_begin_ == buffer_end_) {
+        return false;
+    }
+    size_t record_size = std::min(record_size_ == 0 ? SIZE_MAX : record_size_, buffer_end_ - buffer_begin_);
+    record_data = std::string_view(buffer_.data() + buffer_begin_, record_size);
+    buffer_begin_ += record_size;
+    return true;
+}
+
+// @brief:  read the 4-byte big-endian size of a frame
+// @params: const char *header_data
+// @return: size_t
+// @author: Donghan Xia, 2026/10/17
+static size_t ParseFrameHeader(const char *header_data) {
+    size_t frame_size = 0;
+    for (int byte_index = 0; byte_index < RECORD_FRAME_HEADER_SIZE; byte_index++) {
+        frame_size = (frame_size << 8) | (uint8_t) header_data[byte_index];
+    }
+    return frame_size;
+}
+
+// @brief:  get the bytes of the next frame, a frame cut short by the end of the input or with a size
+//          ... beyond RECORD_MAX_FRAME_SIZE is reported and ends the input
+// @params: std::string_view &record_data, the pass by reference params to store the record
+// @return: bool, false if there is no frame left
+// @author: Donghan Xia, 2026/10/17
+bool RecordReader::NextFrame(std::string_view &record_data) {
+    const char *header_data;
+    size_t available_size;
+    if (!is_stdin_) {
+        header_data = remaining_data_.data();
+        available_size = remaining_data_.size();
+    } else {
+        FillBuffer(RECORD_FRAME_HEADER_SIZE);
+        header_data = buffer_.data() + buffer_begin_;
+        available_size = buffer_end_ - buffer_begin_;
+    }
+    if (available_size == 0) {
+        return false;
+    }
+
+    size_t frame_size = available_size < RECORD_FRAME_HEADER_SIZE ? 0 : ParseFrameHeader(header_data);
+    if (available_size < RECORD_FRAME_HEADER_SIZE || frame_size > RECORD_MAX_FRAME_SIZE) {
+        std::cerr << "invalid frame header, the rest of the input is dropped" << std::endl;
+        remaining_data_ = std::string_view();
+        buffer_begin_ = buffer_end_;
+        is_input_end_ = true;
+        return false;
+    }
+
+    size_t total_size = RECORD_FRAME_HEADER_SIZE + frame_size;
+    if (!is_stdin_) {
+        if (available_size < total_size) {
+            std::cerr << "the last frame is cut short, " << available_size - RECORD_FRAME_HEADER_SIZE
+                    << " of its " << frame_size << " bytes are dropped" << std::endl;
+            remaining_data_ = std::string_view();
+            return false;
+        }
+        record_data = remaining_data_.substr(RECORD_FRAME_HEADER_SIZE, frame_size);
+        remaining_data_.remove_prefix(total_size);
+        file_reader_.ReleaseBefore(record_data.data());
+        return true;
+    }
+
+    if (!FillBuffer(total_size)) {
+        std::cerr << "the last frame is cut short, " << buffer_end_ - buffer_begin_ - RECORD_FRAME_HEADER_SIZE
+                << " of its " << frame_size << " bytes are dropped" << std::endl;
+        buffer_begin_ = buffer_end_;
+        return false;
+    }
+    record_data = std::string_view(buffer_.data() + buffer_begin_ + RECORD_FRAME_HEADER_SIZE, frame_size);
+    buffer_begin_ += total_size;
+    return true;
+}
+
+// @brief:  read stdin until at least min_size unread bytes are buffered or stdin ends, the unread
+//          ... bytes are moved to the front of the buffer first so the buffer does not grow with the
+//          ... input size
+// @params: size_t min_size
+// @return: bool, false if fewer than min_size bytes are buffered
+// @author: Donghan Xia, 2026/10/17
+bool RecordReader::FillBuffer(size_t min_size) {
+    if (buffer_end_ - buffer_begin_ >= min_size) {
+        return true;
+    }
+
+    memmove(&buffer_[0], buffer_.data() + buffer_begin_, buffer_end_ - buffer_begin_);
+    buffer_end_ -= buffer_begin_;
+    buffer_begin_ = 0;
+
+    while (buffer_end_ < min_size && !is_input_end_) {
+        // grow by at least RECORD_READ_SIZE and to the record size at once, not one read at a time
+        size_t wanted_size = min_size == SIZE_MAX ? buffer_end_ + RECORD_READ_SIZE : std::max(min_size, RECORD_READ_SIZE);
+        if (buffer_.size() < wanted_size) {
+            buffer_.resize(std::max(wanted_size, buffer_.size() * 2));
+        }
+
+        ssize_t read_size = read(STDIN_FILENO, &buffer_[buffer_end_], buffer_.size() - buffer_end_);
+        if (read_size <= 0) {
+            is_input_end_ = true;
+        } else {
+            buffer_end_ += read_size;
+        }
+    }
+    return buffer_end_ >= min_size;
+}
+
+// @brief:  prepare to write records to stdout
+// @params: bool is_framed, whether every record is written as a length-prefixed frame
+// @author: Donghan Xia, 2026/10/17
+RecordWriter::RecordWriter(bool is_framed) : is_framed_(is_framed) {
+    output_data_.reserve(RECORD_WRITE_SIZE);
+    EnlargePipeBuffer(STDOUT_FILENO);
+}
+
+// @brief:  start a record of record_size bytes, which writes its frame header if framed
+// @params: size_t record_size, the total size of the Write() calls that follow
+// @return: void
+// @author: Donghan Xia, 2026/10/17
+void RecordWriter::BeginRecord(size_t record_size) {
+    if (!is_framed_) {
+        return;
+    }
+    char header_data[RECORD_FRAME_HEADER_SIZE];
+    for (int byte_index = 0; byte_index < RECORD_FRAME_HEADER_SIZE; byte_index++) {
+        header_data[byte_index] = (char) (record_size >> (8 * (RECORD_FRAME_HEADER_SIZE - 1 - byte_index)));
+    }
+    Write(std::string_view(header_data, RECORD_FRAME_HEADER_SIZE));
+}
+
+// @brief:  append bytes of the current record, a record larger than the buffer is written right
+//          ... away instead of being copied
+// @params: std::string_view record_data
+// @return: void
+// @author: Donghan Xia, 2026/10/17
+void RecordWriter::Write(std::string_view record_data) {
+    if (output_data_.size() + record_data.size() > RECORD_WRITE_SIZE) {
+        Flush();
+    }
+    if (record_data.size() >= RECORD_WRITE_SIZE) {
+        fwrite(record_data.data(), 1, record_data.size(), stdout);
+    } else {
+        output_data_.append(record_data);
+    }
+}
+
+// @brief:  write the buffered bytes to stdout
+// @params: void
+// @return: void
+// @author: Donghan Xia, 2026/10/17
+void RecordWriter::Flush() {
+    fwrite(output_data_.data(), 1, output_data_.size(), stdout);
+    fflush(stdout);
+    output_data_.clear();
+}
+
+// @brief:  grow the kernel buffer of a pipe to RECORD_PIPE_SIZE, so a 1 MiB write or read moves in
+//          ... one system call instead of sixteen, nothing happens if the descriptor is not a pipe or
+//          ... the system has no F_SETPIPE_SZ
+// @params: int file_descriptor
+// @return: void
+// @author: Donghan Xia, 2026/10/17
+void EnlargePipeBuffer(int file_descriptor) {
+#ifdef F_SETPIPE_SZ
+    if (fcntl(file_descriptor, F_GETPIPE_SZ) < RECORD_PIPE_SIZE) {
+        fcntl(file_descriptor, F_SETPIPE_SZ, RECORD_PIPE_SIZE);
+    }
+#else
+    (void) file_descriptor;
+#endif
+}
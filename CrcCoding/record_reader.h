@@ -0,0 +1,75 @@
+#ifndef RECORD_READER_H
+#define RECORD_READER_H
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+#include "mmap_reader.h"
+
+// number of bytes read from stdin at a time
+#define RECORD_READ_SIZE ((size_t) 1 << 20)
+// number of bytes collected before they are written to stdout
+#define RECORD_WRITE_SIZE ((size_t) 1 << 20)
+// capacity asked for the pipes of stdin and stdout, the default Linux limit of an unprivileged
+// ... process, so each side of a pipe moves 1 MiB per system call instead of 64 KiB
+#define RECORD_PIPE_SIZE (1 << 20)
+// a frame is its size as a 4-byte big-endian number followed by that many bytes
+#define RECORD_FRAME_HEADER_SIZE 4
+// largest frame accepted, a larger size means the stream is not made of frames
+#define RECORD_MAX_FRAME_SIZE ((size_t) 1 << 30)
+
+// reader of raw binary records from a file or from stdin ("-")
+// a file is memory-mapped and every record is a view into the mapping like the lines of MmapReader,
+// ... stdin is read into a buffer and a record stays valid until the next one is read
+// the records are record_size bytes each, except the last one which may be shorter, and a
+// ... record_size of 0 reads the whole input as one record
+// a framed input is a stream of length-prefixed frames instead, each frame is one record of its own
+// ... size, so a stream of records of any sizes can go through a pipe
+class RecordReader {
+public:
+    RecordReader(const std::string &file_name, size_t record_size, bool is_framed = false);
+
+    bool IsOpen() const;
+
+    bool NextRecord(std::string_view &record_data);
+
+private:
+    bool NextFrame(std::string_view &record_data);
+
+    bool FillBuffer(size_t min_size);
+
+    size_t record_size_;
+    bool is_framed_;
+    bool is_stdin_;
+    MmapReader file_reader_;
+    // the part of the mapped file after the last record returned
+    std::string_view remaining_data_;
+    // bytes read from stdin, the unread ones are buffer_[buffer_begin_, buffer_end_)
+    std::string buffer_;
+    size_t buffer_begin_ = 0;
+    size_t buffer_end_ = 0;
+    bool is_input_end_ = false;
+};
+
+// buffered writer of raw binary records to stdout, either back to back or as length-prefixed frames
+// ... that a framed RecordReader reads back
+class RecordWriter {
+public:
+    explicit RecordWriter(bool is_framed);
+
+    void BeginRecord(size_t record_size);
+
+    void Write(std::string_view record_data);
+
+    void Flush();
+
+private:
+    bool is_framed_;
+    // bytes waiting to be written, flushed once RECORD_WRITE_SIZE bytes are collected
+    std::string output_data_;
+};
+
+void EnlargePipeBuffer(int file_descriptor);
+
+#endif
@@ -0,0 +1,183 @@
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "result_writer.h"
+
+// @brief:  open the output, a binary results file starts with its header
+// @params: Mode mode
+//          std::string output_name, "-" for stdout, empty for a writer without an output
+//          std::vector<std::string> code_names, the names of the code indexes in the summary and
+//          ... the header, e.g. {"crc", "checksum"}
+// @author: Donghan Xia, 2026/10/17
+ResultWriter::ResultWriter(Mode mode, const std::string &output_name, const std::vector<std::string> &code_names)
+        : mode_(mode), code_names_(code_names), status_counts_(code_names.size()) {
+    buffer_.reserve(RESULT_BUFFER_SIZE + RESULT_RECORD_SIZE);
+
+    if (output_name == "-") {
+        output_file_ = stdout;
+    } else if (!output_name.empty()) {
+        output_file_ = fopen(output_name.c_str(), mode == BINARY ? "wb" : "w");
+        if (output_file_ == nullptr) {
+            std::cerr << "cannot open the output file: " << output_name << std::endl;
+            exit(EXIT_FAILURE);
+        }
+        is_owned_file_ = true;
+    }
+
+    if (mode == BINARY && output_file_ != nullptr) {
+        buffer_ += RESULT_FILE_MAGIC;
+        buffer_ += (char) RESULT_FILE_VERSION;
+        buffer_ += (char) code_names.size();
+        for (const std::string &code_name : code_names) {
+            buffer_ += code_name;
+            buffer_ += '\n';
+        }
+    }
+}
+
+// @brief:  write the rest of the buffer and close an output file
+// @author: Donghan Xia, 2026/10/17
+ResultWriter::~ResultWriter() {
+    Flush();
+    if (is_owned_file_) {
+        fclose(output_file_);
+    }
+}
+
+// @brief:  count the result of a record for a code, and in the binary mode append its fixed-size
+//          ... record to the output
+// @params: int code_index
+//          int line_number
+//          uint32_t check_value, the CRC or checksum
+//          int check_width, number of bits of the check value
+//          ResultStatus status
+// @return: void
+// @author: Donghan Xia, 2026/10/17
+void ResultWriter::WriteResult(int code_index, int line_number, uint32_t check_value, int check_width, ResultStatus status) {
+    if ((size_t) code_index >= status_counts_.size()) {
+        status_counts_.resize(code_index + 1);
+    }
+    status_counts_[code_index][status]++;
+
+    if (mode_ != BINARY) {
+        return;
+    }
+    char record_data[RESULT_RECORD_SIZE];
+    for (int byte_index = 0; byte_index < 4; byte_index++) {
+        record_data[byte_index] = (char) ((uint32_t) line_number >> (8 * byte_index));
+        record_data[4 + byte_index] = (char) (check_value >> (8 * byte_index));
+    }
+    record_data[8] = (char) code_index;
+    record_data[9] = (char) status;
+    record_data[10] = (char) check_width;
+    record_data[11] = 0;
+    buffer_.append(record_data, RESULT_RECORD_SIZE);
+
+    if (buffer_.size() >= RESULT_BUFFER_SIZE) {
+        Flush();
+    }
+}
+
+// @brief:  append the buffer and the counts of a writer without an output, e.g. of a batch
+// @params: ResultWriter other
+// @return: void
+// @author: Donghan Xia, 2026/10/17
+void ResultWriter::Merge(const ResultWriter &other) {
+    if (other.status_counts_.size() > status_counts_.size()) {
+        status_counts_.resize(other.status_counts_.size());
+    }
+    for (size_t code_index = 0; code_index < other.status_counts_.size(); code_index++) {
+        for (int status = 0; status < RESULT_STATUS_COUNT; status++) {
+            status_counts_[code_index][status] += other.status_counts_[code_index][status];
+        }
+    }
+
+    if (buffer_.size() + other.buffer_.size() >= RESULT_BUFFER_SIZE) {
+        Flush();
+    }
+    // a large buffer is written right away instead of being copied
+    if (output_file_ != nullptr && other.buffer_.size() >= RESULT_BUFFER_SIZE) {
+        fwrite(other.buffer_.data(), 1, other.buffer_.size(), output_file_);
+    } else {
+        buffer_ += other.buffer_;
+    }
+}
+
+// @brief:  write the buffer to the output, a writer without an output keeps it
+// @params: void
+// @return: void
+// @author: Donghan Xia, 2026/10/17
+void ResultWriter::Flush() {
+    if (output_file_ == nullptr) {
+        return;
+    }
+    fwrite(buffer_.data(), 1, buffer_.size(), output_file_);
+    buffer_.clear();
+}
+
+// @brief:  after the last record: in the summary mode write the counts of every code, e.g.
+//          ... "crc  records: 5  passed: 3  not passed: 2", then write everything out
+// @params: void
+// @return: void
+// @author: Donghan Xia, 2026/10/17
+void ResultWriter::Finish() {
+    if (mode_ == SUMMARY) {
+        static const char *const status_names[RESULT_STATUS_COUNT] = {"encoded", "passed", "not passed", "corrected"};
+        for (size_t code_index = 0; code_index < status_counts_.size(); code_index++) {
+            const std::array<uint64_t, RESULT_STATUS_COUNT> &counts = status_counts_[code_index];
+            uint64_t record_count = 0;
+            for (uint64_t count : counts) {
+                record_count += count;
+            }
+            bool has_check = counts[RESULT_PASSED] + counts[RESULT_FAILED] + counts[RESULT_CORRECTED] > 0;
+
+            buffer_ += code_index < code_names_.size() ? code_names_[code_index] : "code " + std::to_string(code_index);
+            buffer_ += "  records: " + std::to_string(record_count);
+            for (int status = 0; status < RESULT_STATUS_COUNT; status++) {
+                // the encoded count of a checker, and the corrected count without corrections, are
+                // ... always zero
+                bool is_shown = status == RESULT_ENCODED ? !has_check
+                        : status == RESULT_CORRECTED ? counts[status] > 0 : has_check;
+                if (is_shown) {
+                    buffer_ += std::string("  ") + status_names[status] + ": " + std::to_string(counts[status]);
+                }
+            }
+            buffer_ += '\n';
+        }
+    }
+
+    Flush();
+    if (output_file_ != nullptr) {
+        fflush(output_file_);
+    }
+}
+
+// @brief:  get how many records of a code had a status
+// @params: int code_index
+//          ResultStatus status
+// @return: uint64_t
+// @author: Donghan Xia, 2026/10/17
+uint64_t ResultWriter::GetCount(int code_index, ResultStatus status) const {
+    return (size_t) code_index < status_counts_.size() ? status_counts_[code_index][status] : 0;
+}
+
+// @brief:  parse an output mode: "text", "binary" or "summary"
+// @params: std::string mode_name
+//          ResultWriter::Mode &mode, the pass by reference params to store the result
+// @return: bool, false if the mode is unknown
+// @author: Donghan Xia, 2026/10/17
+bool ParseResultMode(const std::string &mode_name, ResultWriter::Mode &mode) {
+    if (mode_name == "text") {
+        mode = ResultWriter::TEXT;
+    } else if (mode_name == "binary") {
+        mode = ResultWriter::BINARY;
+    } else if (mode_name == "summary") {
+        mode = ResultWriter::SUMMARY;
+    } else {
+        return false;
+    }
+    return true;
+}
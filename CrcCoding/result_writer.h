@@ -0,0 +1,105 @@
+#ifndef RESULT_WRITER_H
+#define RESULT_WRITER_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// default output mode of the results, see ParseResultMode()
+#define DEFAULT_RESULT_MODE "text"
+// default output of the results, "-" for stdout
+#define DEFAULT_RESULT_OUTPUT "-"
+// number of bytes collected before they are written to the output
+#define RESULT_BUFFER_SIZE ((size_t) 1 << 20)
+// first bytes of a binary results file, followed by the version, the number of codes and the code
+// ... names each ended by '\n'
+#define RESULT_FILE_MAGIC "CRCRES"
+#define RESULT_FILE_VERSION 1
+// number of bytes of one result in a binary results file
+#define RESULT_RECORD_SIZE 12
+
+// result of one record for one code
+enum ResultStatus {
+    // a codeword was encoded, crc_tx
+    RESULT_ENCODED = 0,
+    RESULT_PASSED = 1,
+    RESULT_FAILED = 2,
+    // rejected but repaired by crc_rx
+    RESULT_CORRECTED = 3,
+    RESULT_STATUS_COUNT = 4,
+};
+
+// buffered writer of the results of crc_tx, crc_rx and crc_vs_checksum, which replaces a flush and a
+// ... write system call per line with one write per RESULT_BUFFER_SIZE bytes, in one of three modes:
+//     TEXT     the text of every record, as the tools always printed it
+//     BINARY   RESULT_RECORD_SIZE bytes per result: the line number and the check value as 32-bit
+//              ... little-endian numbers, the code index, the ResultStatus, the check width and a
+//              ... zero byte, after the RESULT_FILE_MAGIC header
+//     SUMMARY  nothing per record, only the count of every ResultStatus of every code at the end
+// the results of every code are counted in every mode
+// a writer without an output keeps everything in its buffer, e.g. for a batch that is encoded on a
+// ... worker thread and merged into the real output in order later
+class ResultWriter {
+public:
+    enum Mode {
+        TEXT,
+        BINARY,
+        SUMMARY,
+    };
+
+    explicit ResultWriter(Mode mode, const std::string &output_name = "", const std::vector<std::string> &code_names = {});
+
+    ~ResultWriter();
+
+    ResultWriter(const ResultWriter &) = delete;
+
+    ResultWriter &operator=(const ResultWriter &) = delete;
+
+    Mode GetMode() const {
+        return mode_;
+    }
+
+    // whether the stages need to format the text of their records
+    bool IsTextMode() const {
+        return mode_ == TEXT;
+    }
+
+    // @brief:  append text, only used in the text mode
+    // @params: std::string_view text_data
+    // @return: void
+    // @author: Donghan Xia, 2026/10/17
+    void WriteText(std::string_view text_data) {
+        buffer_.append(text_data);
+        if (buffer_.size() >= RESULT_BUFFER_SIZE) {
+            Flush();
+        }
+    }
+
+    void WriteResult(int code_index, int line_number, uint32_t check_value, int check_width, ResultStatus status);
+
+    void Merge(const ResultWriter &other);
+
+    void Flush();
+
+    void Finish();
+
+    uint64_t GetCount(int code_index, ResultStatus status) const;
+
+private:
+    Mode mode_;
+    std::vector<std::string> code_names_;
+    // nullptr for a writer without an output
+    FILE *output_file_ = nullptr;
+    bool is_owned_file_ = false;
+    std::string buffer_;
+    // status_counts_[code_index][status], grows with the code indexes written
+    std::vector<std::array<uint64_t, RESULT_STATUS_COUNT>> status_counts_;
+};
+
+bool ParseResultMode(const std::string &mode_name, ResultWriter::Mode &mode);
+
+#endif
@@ -0,0 +1,107 @@
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <mutex>
+
+#include "stage_profiler.h"
+
+// whether the pipelines count the ticks of their stages, set once before any pipeline runs
+static bool is_profiling_enabled = false;
+// counters of every finished pipeline run
+static std::mutex total_counters_mutex;
+static StageCounters total_counters;
+// the ticks and the clock when the profiling started, to convert the ticks into seconds
+static uint64_t start_ticks = 0;
+static std::chrono::steady_clock::time_point start_time;
+
+// @brief:  start the profiling, call it before any pipeline runs
+// @params: void
+// @return: void
+// @author: Donghan Xia, 2026/10/17
+void EnableStageProfiling() {
+    is_profiling_enabled = true;
+    start_time = std::chrono::steady_clock::now();
+    start_ticks = ReadProfileTicks();
+}
+
+// @brief:  check whether the pipelines should count the ticks of their stages
+// @params: void
+// @return: bool
+// @author: Donghan Xia, 2026/10/17
+bool IsStageProfilingEnabled() {
+    return is_profiling_enabled;
+}
+
+// @brief:  add the counters of a finished pipeline run to the totals, from any thread
+// @params: StageCounters counters
+// @return: void
+// @author: Donghan Xia, 2026/10/17
+void MergeStageCounters(const StageCounters &counters) {
+    std::lock_guard<std::mutex> counters_lock(total_counters_mutex);
+    for (int stage = 0; stage < PROFILE_STAGE_COUNT; stage++) {
+        total_counters.stage_ticks[stage] += counters.stage_ticks[stage];
+    }
+    total_counters.record_count += counters.record_count;
+    total_counters.bit_count += counters.bit_count;
+    for (int bucket_index = 0; bucket_index < PROFILE_HISTOGRAM_SIZE; bucket_index++) {
+        total_counters.latency_counts[bucket_index] += counters.latency_counts[bucket_index];
+    }
+}
+
+// @brief:  print the profile to stderr: the time and the share of every stage, the records/s and
+//          ... bits/s over the wall time, and the histogram of the record latencies
+//          the stage times are summed over the threads, so with worker threads they may add up to
+//          ... more than the wall time
+// @params: void
+// @return: void
+// @author: Donghan Xia, 2026/10/17
+void PrintStageProfile() {
+    static const char *const stage_names[PROFILE_STAGE_COUNT] = {"read", "parse", "encode", "inject", "check", "output"};
+
+    double wall_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+    uint64_t wall_ticks = ReadProfileTicks() - start_ticks;
+    double ticks_per_second = wall_seconds > 0 ? wall_ticks / wall_seconds : 1e9;
+
+    std::lock_guard<std::mutex> counters_lock(total_counters_mutex);
+    const StageCounters &counters = total_counters;
+    uint64_t total_ticks = 0;
+    for (uint64_t stage_ticks : counters.stage_ticks) {
+        total_ticks += stage_ticks;
+    }
+
+    char row_data[160];
+    std::cerr << "stage       time (s)   share   ns/record" << std::endl;
+    for (int stage = 0; stage < PROFILE_STAGE_COUNT; stage++) {
+        double stage_seconds = counters.stage_ticks[stage] / ticks_per_second;
+        snprintf(row_data, sizeof(row_data), "%-8s %11.6f %6.1f%% %11.1f", stage_names[stage], stage_seconds,
+                total_ticks > 0 ? 100.0 * counters.stage_ticks[stage] / total_ticks : 0.0,
+                counters.record_count > 0 ? stage_seconds * 1e9 / counters.record_count : 0.0);
+        std::cerr << row_data << std::endl;
+    }
+    snprintf(row_data, sizeof(row_data), "records: %llu  bits: %llu  wall time: %.6f s  %.0f records/s  %.4g bits/s",
+            (unsigned long long) counters.record_count, (unsigned long long) counters.bit_count, wall_seconds,
+            wall_seconds > 0 ? counters.record_count / wall_seconds : 0.0,
+            wall_seconds > 0 ? counters.bit_count / wall_seconds : 0.0);
+    std::cerr << row_data << std::endl;
+
+    // every nonempty bucket, with the bucket where the median and the 99th percentile fall
+    std::cerr << "latency per record    records   share" << std::endl;
+    uint64_t counted_records = 0;
+    for (int bucket_index = 0; bucket_index < PROFILE_HISTOGRAM_SIZE; bucket_index++) {
+        uint64_t bucket_count = counters.latency_counts[bucket_index];
+        if (bucket_count == 0) {
+            continue;
+        }
+        bool is_median = counted_records * 2 < counters.record_count
+                && (counted_records + bucket_count) * 2 >= counters.record_count;
+        bool is_tail = counted_records * 100 < counters.record_count * 99
+                && (counted_records + bucket_count) * 100 >= counters.record_count * 99;
+        counted_records += bucket_count;
+
+        double bucket_end_ns = (double) ((uint64_t) 1 << bucket_index) / ticks_per_second * 1e9;
+        snprintf(row_data, sizeof(row_data), "  < %12.0f ns %10llu %6.1f%%%s%s", bucket_end_ns,
+                (unsigned long long) bucket_count, 100.0 * bucket_count / counters.record_count,
+                is_median ? "  p50" : "", is_tail ? "  p99" : "");
+        std::cerr << row_data << std::endl;
+    }
+}
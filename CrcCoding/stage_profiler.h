@@ -0,0 +1,73 @@
+#ifndef STAGE_PROFILER_H
+#define STAGE_PROFILER_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+// number of buckets of the latency histogram, bucket b counts the records of [2^(b-1), 2^b) ticks
+#define PROFILE_HISTOGRAM_SIZE 64
+
+// what a pipeline stage spends its time on, every stage names one as kProfileStage
+enum ProfileStage {
+    // the source, reading the next record
+    PROFILE_READ,
+    // packing the bit characters
+    PROFILE_PARSE,
+    PROFILE_ENCODE,
+    // introducing the error bits
+    PROFILE_INJECT,
+    PROFILE_CHECK,
+    // formatting and writing the results
+    PROFILE_OUTPUT,
+    PROFILE_STAGE_COUNT,
+};
+
+// counters of one pipeline run on one thread, kept without any lock and merged into the totals of
+// ... the program once the run ends
+struct StageCounters {
+    uint64_t stage_ticks[PROFILE_STAGE_COUNT] = {};
+    uint64_t record_count = 0;
+    // bit characters of the text lines, 8 per byte of the binary records
+    uint64_t bit_count = 0;
+    // ticks from reading a record through its last stage
+    uint64_t latency_counts[PROFILE_HISTOGRAM_SIZE] = {};
+};
+
+// @brief:  read the time stamp counter, which costs a few cycles instead of a clock system call,
+//          ... or the steady clock in nanoseconds on other CPUs
+// @params: void
+// @return: uint64_t, ticks
+// @author: Donghan Xia, 2026/10/17
+inline uint64_t ReadProfileTicks() {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+// @brief:  count the latency of one record in its histogram bucket
+// @params: StageCounters &counters
+//          uint64_t latency_ticks
+// @return: void
+// @author: Donghan Xia, 2026/10/17
+inline void CountRecordLatency(StageCounters &counters, uint64_t latency_ticks) {
+    int bucket_index = latency_ticks == 0 ? 0 : 64 - __builtin_clzll(latency_ticks);
+    counters.latency_counts[bucket_index < PROFILE_HISTOGRAM_SIZE ? bucket_index : PROFILE_HISTOGRAM_SIZE - 1]++;
+}
+
+void EnableStageProfiling();
+
+bool IsStageProfilingEnabled();
+
+void MergeStageCounters(const StageCounters &counters);
+
+void PrintStageProfile();
+
+#endif
@@ -0,0 +1,169 @@
+#include <algorithm>
+#include <cstdint>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "thread_pool.h"
+
+// index of the queue owned by the current thread, the threads outside the pool own none
+static thread_local size_t own_queue_index = SIZE_MAX;
+
+// @brief:  start thread_count worker threads
+// @params: int thread_count, number of worker threads, 0 for one per core
+// @return: void
+// @author: Donghan Xia, 2026/10/17
+WorkStealingPool::WorkStealingPool(int thread_count) : queued_count_(0), next_queue_(0), is_stopping_(false) {
+    thread_count = ResolveThreadCount(thread_count);
+
+    for (int worker_index = 0; worker_index < thread_count; worker_index++) {
+        queues_.push_back(std::unique_ptr<WorkerQueue>(new WorkerQueue()));
+    }
+    for (int worker_index = 0; worker_index < thread_count; worker_index++) {
+        workers_.emplace_back(&WorkStealingPool::RunWorker, this, worker_index);
+    }
+}
+
+// @brief:  let the workers finish the queued tasks and join them
+// @params: void
+// @return: void
+// @author: Donghan Xia, 2026/10/17
+WorkStealingPool::~WorkStealingPool() {
+    {
+        std::lock_guard<std::mutex> wake_lock(wake_mutex_);
+        is_stopping_ = true;
+    }
+    wake_condition_.notify_all();
+
+    for (std::thread &worker : workers_) {
+        worker.join();
+    }
+}
+
+// @brief:  get the number of worker threads
+// @params: void
+// @return: int
+// @author: Donghan Xia, 2026/10/17
+int WorkStealingPool::GetThreadCount() const {
+    return workers_.size();
+}
+
+// @brief:  queue a task, a task submitted by a worker goes to the worker's own queue, any other
+//          ... task goes to the queues in turn
+// @params: std::function<void()> task
+// @return: void
+// @author: Donghan Xia, 2026/10/17
+void WorkStealingPool::Submit(std::function<void ()> task) {
+    size_t queue_index = own_queue_index;
+    if (queue_index >= queues_.size()) {
+        queue_index = next_queue_.fetch_add(1) % queues_.size();
+    }
+
+    {
+        std::lock_guard<std::mutex> queue_lock(queues_[queue_index]->mutex);
+        queues_[queue_index]->tasks.push_back(std::move(task));
+    }
+    {
+        // the counter is changed under the wake mutex so that no sleeping worker misses it
+        std::lock_guard<std::mutex> wake_lock(wake_mutex_);
+        queued_count_++;
+    }
+    wake_condition_.notify_one();
+}
+
+// @brief:  run task(0) ... task(task_count - 1) on the pool and wait for all of them
+//          the calling thread does not sit idle, it steals and runs queued tasks while waiting
+// @params: size_t task_count
+//          std::function<void(size_t)> task, called once with each task index
+// @return: void
+// @author: Donghan Xia, 2026/10/17
+void WorkStealingPool::ParallelFor(size_t task_count, std::function<void (size_t)> const& task) {
+    std::atomic<size_t> remaining_count(task_count);
+
+    for (size_t task_index = 0; task_index < task_count; task_index++) {
+        Submit([this, &task, &remaining_count, task_index]() {
+            task(task_index);
+            if (remaining_count.fetch_sub(1) == 1) {
+                std::lock_guard<std::mutex> wake_lock(wake_mutex_);
+                done_condition_.notify_all();
+            }
+        });
+    }
+
+    std::function<void ()> stolen_task;
+    while (remaining_count.load() > 0) {
+        size_t queue_index = own_queue_index < queues_.size() ? own_queue_index : 0;
+        if (PopTask(queue_index, stolen_task)) {
+            stolen_task();
+            continue;
+        }
+
+        std::unique_lock<std::mutex> wake_lock(wake_mutex_);
+        done_condition_.wait(wake_lock, [this, &remaining_count]() {
+            return remaining_count.load() == 0 || queued_count_.load() > 0;
+        });
+    }
+}
+
+// @brief:  take a task from the back of the given queue, or steal one from the front of another queue
+// @params: size_t queue_index
+//          std::function<void()> &task, the pass by reference params to store the task
+// @return: bool, false if every queue is empty
+// @author: Donghan Xia, 2026/10/17
+bool WorkStealingPool::PopTask(size_t queue_index, std::function<void ()> &task) {
+    for (size_t offset = 0; offset < queues_.size(); offset++) {
+        WorkerQueue &queue = *queues_[(queue_index + offset) % queues_.size()];
+        std::lock_guard<std::mutex> queue_lock(queue.mutex);
+        if (queue.tasks.empty()) {
+            continue;
+        }
+
+        if (offset == 0) {
+            task = std::move(queue.tasks.back());
+            queue.tasks.pop_back();
+        } else {
+            task = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+        }
+        queued_count_--;
+        return true;
+    }
+    return false;
+}
+
+// @brief:  worker loop, run tasks until the pool is stopping and every queue is empty
+// @params: size_t worker_index
+// @return: void
+// @author: Donghan Xia, 2026/10/17
+void WorkStealingPool::RunWorker(size_t worker_index) {
+    own_queue_index = worker_index;
+    std::function<void ()> task;
+
+    while (true) {
+        if (PopTask(worker_index, task)) {
+            task();
+            continue;
+        }
+
+        std::unique_lock<std::mutex> wake_lock(wake_mutex_);
+        wake_condition_.wait(wake_lock, [this]() {
+            return is_stopping_ || queued_count_.load() > 0;
+        });
+        if (is_stopping_ && queued_count_.load() == 0) {
+            return;
+        }
+    }
+}
+
+// @brief:  turn the thread count of the command line into the actual number of threads
+// @params: int thread_count, 0 for one thread per core
+// @return: int, at least 1
+// @author: Donghan Xia, 2026/10/17
+int ResolveThreadCount(int thread_count) {
+    if (thread_count <= 0) {
+        thread_count = std::thread::hardware_concurrency();
+    }
+    return std::max(thread_count, 1);
+}
@@ -0,0 +1,54 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// fixed-size pool of worker threads with one task queue per worker
+// a worker takes tasks from the back of its own queue and, once it runs dry, steals from the front
+// ... of the other queues, so uneven tasks (e.g. the last short chunk of a record) do not leave
+// ... the other cores idle
+class WorkStealingPool {
+public:
+    explicit WorkStealingPool(int thread_count);
+
+    ~WorkStealingPool();
+
+    int GetThreadCount() const;
+
+    void Submit(std::function<void ()> task);
+
+    void ParallelFor(size_t task_count, std::function<void (size_t)> const& task);
+
+private:
+    struct WorkerQueue {
+        std::mutex mutex;
+        std::deque<std::function<void ()>> tasks;
+    };
+
+    bool PopTask(size_t queue_index, std::function<void ()> &task);
+
+    void RunWorker(size_t worker_index);
+
+    std::vector<std::unique_ptr<WorkerQueue>> queues_;
+    std::vector<std::thread> workers_;
+    // number of tasks waiting in the queues
+    std::atomic<size_t> queued_count_;
+    // queue that receives the next task submitted from outside the pool
+    std::atomic<size_t> next_queue_;
+    std::mutex wake_mutex_;
+    std::condition_variable wake_condition_;
+    std::condition_variable done_condition_;
+    bool is_stopping_;
+};
+
+int ResolveThreadCount(int thread_count);
+
+#endif